@@ -37,7 +37,12 @@ namespace dynamo {
 
     inline size_t getParticleID() const
     { return particleID; }
-  
+
+    //! \brief Used to renumber the particle when the event is
+    //! transferred between Simulation's.
+    inline void setParticleID(const size_t ID)
+    { particleID = ID; }
+
     inline Vector getOldVel() const
     { return oldVelVec; }
 
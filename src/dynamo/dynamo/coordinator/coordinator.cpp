@@ -131,7 +131,9 @@ namespace dynamo {
        " Values:\n"
        "  1: \tStandard Engine\n"
        "  2: \tNVT Replica Exchange Engine\n"
-       "  3: \tCompression Engine")
+       "  3: \tCompression Engine\n"
+       "  4: \tParallel Domain Engine\n"
+       "  5: \tMulti-process Domain Engine")
       ;
 
     basicOpts.add(systemopts).add(engineopts);
@@ -139,6 +141,7 @@ namespace dynamo {
     Engine::getCommonOptions(detailedEngineOpts);
     EReplicaExchangeSimulation::getOptions(detailedEngineOpts);
     ECompressingSimulation::getOptions(detailedEngineOpts);
+    EParallelDomainSimulation::getOptions(detailedEngineOpts);
   
     allopts.add(basicOpts).add(detailedEngineOpts);
 
@@ -185,6 +188,12 @@ namespace dynamo {
       case (3):
 	_engine = shared_ptr<ECompressingSimulation>(new ECompressingSimulation(vm, _threads));
 	break;
+      case (4):
+	_engine = shared_ptr<EParallelDomainSimulation>(new EParallelDomainSimulation(vm, _threads));
+	break;
+      case (5):
+	_engine = shared_ptr<EProcessDomainSimulation>(new EProcessDomainSimulation(vm, _threads));
+	break;
       default:
 	M_throw() << vm["engine"].as<size_t>()
 		  <<", Unknown Engine Number Selected"; 
@@ -18,3 +18,5 @@
 #include <dynamo/coordinator/engine/replexer.hpp>
 #include <dynamo/coordinator/engine/single.hpp>
 #include <dynamo/coordinator/engine/compressor.hpp>
+#include <dynamo/coordinator/engine/parallel.hpp>
+#include <dynamo/coordinator/engine/process.hpp>
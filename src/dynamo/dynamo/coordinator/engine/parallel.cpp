@@ -0,0 +1,659 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/coordinator/engine/parallel.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <dynamo/BC/PBC.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/neighbourlist.hpp>
+#include <dynamo/globals/neighbourList.hpp>
+#include <dynamo/globals/PBCSentinel.hpp>
+#include <dynamo/interactions/captures.hpp>
+#include <dynamo/ranges/IDRangeAll.hpp>
+#include <dynamo/ranges/IDPairRangeAll.hpp>
+#include <dynamo/species/species.hpp>
+#include <dynamo/systems/tHalt.hpp>
+#include <dynamo/systems/sysTicker.hpp>
+#include <dynamo/systems/snapshot.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <typeinfo>
+
+namespace dynamo {
+  namespace {
+    //! \brief Consecutive rollbacks before events are run serially.
+    const size_t maxRollbacks = 4;
+    //! \brief The growth of the window after a successful window.
+    const double windowGrowth = 1.25;
+    //! \brief The largest window, as a multiple of the initial window.
+    const double maxWindowFactor = 8;
+    //! \brief The tolerance (in simulation units) when comparing trajectories.
+    const double trajectoryTolerance = 1e-8;
+
+    /*! \brief Suppresses the screen output while in scope.
+
+      The sub-simulations of the domains are rebuilt every window,
+      which would otherwise flood the screen with their
+      initialisation output. Errors are still written to std::cerr.
+    */
+    struct SuppressOutput
+    {
+      SuppressOutput() { std::cout.setstate(std::ios::failbit); }
+      ~SuppressOutput() { std::cout.clear(); }
+    };
+  }
+
+  /*! \brief Records the trajectories and events of a domain
+    sub-simulation.
+
+    Every event is used to track the displacements and event counts
+    of the particles. An event is only stored for replay if the
+    lowest ID particle involved is owned by the domain, so that each
+    event crossing the domain boundaries is only replayed once.
+  */
+  struct EParallelDomainSimulation::DomainRecorder: public OutputPlugin
+  {
+    DomainRecorder(const Simulation* sim, Domain& domain, const std::vector<size_t>& owner):
+      OutputPlugin(sim, "DomainRecorder"),
+      _domain(domain),
+      _owner(owner),
+      _lastEventCount(0)
+    {}
+
+    virtual void initialise() {}
+
+    void reset() { _lastEventCount = Sim->eventCount; }
+
+    virtual void eventUpdate(const Event& event, const NEventData& data)
+    {
+      const bool counted = (Sim->eventCount != _lastEventCount);
+      _lastEventCount = Sim->eventCount;
+
+      size_t firstID = std::numeric_limits<size_t>::max();
+      for (const ParticleEventData& pdat : data.L1partChanges)
+	firstID = std::min(firstID, trackParticle(pdat));
+
+      for (const PairEventData& pdat : data.L2partChanges)
+	firstID = std::min(firstID, std::min(trackParticle(pdat.particle1_), trackParticle(pdat.particle2_)));
+
+      if ((firstID == std::numeric_limits<size_t>::max()) || (_owner[firstID] != _domain.index))
+	return;
+
+      _domain.events.push_back(Domain::EventRecord());
+      Domain::EventRecord& record = _domain.events.back();
+      record.time = Sim->systemTime;
+      record.event = event;
+      record.data = data;
+      record.counted = counted;
+
+      if (event._source != SYSTEM)
+	record.event._particle1ID = _domain.globalID[event._particle1ID];
+      if (event._source == INTERACTION)
+	record.event._particle2ID = _domain.globalID[event._particle2ID];
+
+      for (ParticleEventData& pdat : record.data.L1partChanges)
+	storeParticle(record, pdat);
+
+      for (PairEventData& pdat : record.data.L2partChanges)
+	{
+	  storeParticle(record, pdat.particle1_);
+	  storeParticle(record, pdat.particle2_);
+	}
+    }
+
+  private:
+    //! \brief Updates the statistics of a particle and returns its
+    //! ID in the main Simulation.
+    size_t trackParticle(const ParticleEventData& pdat)
+    {
+      const size_t ID = pdat.getParticleID();
+      const double disp = Sim->particles[ID].getPosition()[0] - _domain.startX[ID];
+      _domain.minDisp[ID] = std::min(_domain.minDisp[ID], disp);
+      _domain.maxDisp[ID] = std::max(_domain.maxDisp[ID], disp);
+      if (pdat.getType() != VIRTUAL)
+	++_domain.eventCounts[ID];
+      return _domain.globalID[ID];
+    }
+
+    void storeParticle(Domain::EventRecord& record, ParticleEventData& pdat)
+    {
+      const size_t ID = pdat.getParticleID();
+      const Particle& part = Sim->particles[ID];
+      Vector pos = part.getPosition();
+      pos[0] += _domain.offset[ID];
+      record.states.push_back(Domain::ParticleState(_domain.globalID[ID], pos, part.getVelocity()));
+      pdat.setParticleID(_domain.globalID[ID]);
+    }
+
+    Domain& _domain;
+    const std::vector<size_t>& _owner;
+    size_t _lastEventCount;
+  };
+
+  void
+  EParallelDomainSimulation::getOptions(boost::program_options::options_description& opts)
+  {
+    boost::program_options::options_description ropts("Parallel Domain Engines (--engine=4 and 5)");
+
+    ropts.add_options()
+      ("domains", boost::program_options::value<size_t>(),
+       "Number of slabs (along the x axis) the system is divided into, each executed by a thread (--engine=4) or process (--engine=5). Defaults to the number of threads (at least 2)")
+      ("domain-halo", boost::program_options::value<double>()->default_value(3.0),
+       "Thickness of the halo of particles simulated around each domain, in units of the longest interaction range")
+      ("domain-window", boost::program_options::value<double>()->default_value(1.0),
+       "Initial time between the synchronisations of the domains, in units of the mean free time")
+      ;
+    opts.add(ropts);
+  }
+
+  EParallelDomainSimulation::EParallelDomainSimulation(const boost::program_options::variables_map& nVM,
+						       magnet::thread::ThreadPool& tp):
+    ESingleSimulation(nVM, tp),
+    _boxLength(0),
+    _slabWidth(0),
+    _halo(0),
+    _interactionRange(0),
+    _baseWindow(0),
+    _window(0),
+    _serialRunLength(0),
+    _schedulerStale(false),
+    _nextPrint(0),
+    _committedWindows(0),
+    _rolledBackWindows(0),
+    _serialEvents(0)
+  {}
+
+  EParallelDomainSimulation::~EParallelDomainSimulation() {}
+
+  void
+  EParallelDomainSimulation::postSimInit(Simulation& sim)
+  {
+    ESingleSimulation::postSimInit(sim);
+
+    if (typeid(*sim.BCs) != typeid(BCPeriodic))
+      M_throw() << "The parallel domain engine requires periodic boundary conditions";
+
+    if ((typeid(*sim.dynamics) != typeid(DynNewtonian)) || sim.dynamics->hasOrientationData())
+      M_throw() << "The parallel domain engine only supports Newtonian dynamics without orientation data";
+
+    if (!std::dynamic_pointer_cast<SNeighbourList>(sim.ptrScheduler))
+      M_throw() << "The parallel domain engine requires a neighbour list scheduler";
+
+    if (!sim.locals.empty())
+      M_throw() << "The parallel domain engine does not support Locals";
+
+    if (!sim.topology.empty())
+      M_throw() << "The parallel domain engine does not support Topology";
+
+    //The particles are renumbered in the domains
+    if (sim._properties.hasParticleProperties())
+      M_throw() << "The parallel domain engine does not support per-particle properties";
+
+    for (const shared_ptr<Species>& species : sim.species)
+      if (!std::dynamic_pointer_cast<IDRangeAll>(species->getRange()))
+	M_throw() << "The parallel domain engine requires that the Species \"" << species->getName() << "\" contains all particles";
+
+    for (const shared_ptr<Interaction>& interaction : sim.interactions)
+      {
+	if (!std::dynamic_pointer_cast<IDPairRangeAll>(interaction->getRange()))
+	  M_throw() << "The parallel domain engine requires that the Interaction \"" << interaction->getName() << "\" applies to all pairs";
+
+	if (std::dynamic_pointer_cast<ICapture>(interaction))
+	  M_throw() << "The parallel domain engine does not support the captured pairs of the Interaction \"" << interaction->getName() << "\"";
+      }
+
+    for (const shared_ptr<Global>& global : sim.globals)
+      if (!std::dynamic_pointer_cast<GNeighbourList>(global) && !std::dynamic_pointer_cast<GPBCSentinel>(global))
+	M_throw() << "The parallel domain engine does not support the Global \"" << global->getName() << "\"";
+
+    for (const shared_ptr<System>& system : sim.systems)
+      if (!std::dynamic_pointer_cast<SystHalt>(system) && !std::dynamic_pointer_cast<SysTicker>(system)
+	  && !std::dynamic_pointer_cast<SysSnapshot>(system))
+	M_throw() << "The parallel domain engine does not support the System \"" << system->getName() << "\"";
+
+    const size_t domainCount = vm.count("domains") ? vm["domains"].as<size_t>() : std::max(size_t(2), threads.getThreadCount());
+    if (domainCount < 2)
+      M_throw() << "The parallel domain engine requires at least two domains";
+
+    _boxLength = sim.primaryCellSize[0];
+    _slabWidth = _boxLength / domainCount;
+    _interactionRange = sim.getLongestInteraction();
+    _halo = vm["domain-halo"].as<double>() * _interactionRange;
+
+    //The domains are not periodic in x, and their halos must not
+    //overlap across the periodic boundary.
+    const double domainWidth = _slabWidth + 2 * (_halo + _interactionRange);
+    if (domainWidth >= _boxLength)
+      M_throw() << "The system is too small to be split into " << domainCount
+		<< " domains with a halo of " << _halo / sim.units.unitLength();
+
+    _baseWindow = _window = vm["domain-window"].as<double>() * sim.lastRunMFT;
+    _serialRunLength = sim.N();
+    _nextPrint = sim.eventCount + sim.eventPrintInterval;
+
+    _owner.resize(sim.N());
+    _ownerIndex.resize(sim.N());
+    _startX.resize(sim.N());
+    updateOwners();
+
+    SuppressOutput quiet;
+    //The domains are built from the live Simulation (not the
+    //configuration file), as the engine options (e.g., rescaling or
+    //added Systems) may have already altered it.
+    const boost::filesystem::path file = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("dynamo-domains-%%%%-%%%%-%%%%.xml");
+    sim.writeXMLfile(file.string(), false);
+    for (size_t i(0); i < domainCount; ++i)
+      {
+	_domains.push_back(std::unique_ptr<Domain>(new Domain(i, -0.5 * _boxLength + (i + 0.5) * _slabWidth)));
+	Domain& domain = *_domains.back();
+	Simulation& sub = domain.sim;
+
+	sub.loadXMLfile(file.string());
+	sub.BCs = shared_ptr<BoundaryCondition>(new BCPeriodicExceptX(&sub));
+	sub.primaryCellSize[0] = domainWidth;
+	sub.endEventCount = std::numeric_limits<size_t>::max();
+
+	domain.halt = shared_ptr<SystHalt>(new SystHalt(&sub, std::numeric_limits<float>::infinity(), "DomainWindowEnd"));
+	sub.systems.push_back(domain.halt);
+
+	domain.recorder = shared_ptr<DomainRecorder>(new DomainRecorder(&sub, domain, _owner));
+	sub.outputPlugins.push_back(domain.recorder);
+
+	loadDomain(domain);
+	sub.initialise();
+
+	domain.nblist = std::dynamic_pointer_cast<GNeighbourList>(sub.globals["SchedulerNBList"]);
+      }
+    boost::filesystem::remove(file);
+
+    std::cout << "Parallel domain engine: " << domainCount << " domains of width "
+	      << _slabWidth / sim.units.unitLength() << " with a halo of "
+	      << _halo / sim.units.unitLength() << std::endl;
+  }
+
+  void
+  EParallelDomainSimulation::updateOwners()
+  {
+    simulation.dynamics->updateAllParticles();
+
+    const size_t lastDomain = size_t(std::round(_boxLength / _slabWidth)) - 1;
+    for (const Particle& part : simulation.particles)
+      {
+	const double x = part.getPosition()[0];
+	_startX[part.getID()] = x;
+	const double u = relativeX(x, 0) + 0.5 * _boxLength;
+	_owner[part.getID()] = std::min(size_t(std::max(u, 0.0) / _slabWidth), lastDomain);
+      }
+  }
+
+  void
+  EParallelDomainSimulation::loadDomain(Domain& domain)
+  {
+    Simulation& sub = domain.sim;
+
+    //This also zeroes the peculiar time of the Dynamics, so the new
+    //particles are up to date.
+    sub.dynamics->updateAllParticles();
+
+    sub.particles.clear();
+    domain.globalID.clear();
+    domain.offset.clear();
+    domain.startX.clear();
+
+    const double reach = 0.5 * _slabWidth + _halo;
+    for (const Particle& part : simulation.particles)
+      {
+	const size_t ID = part.getID();
+	const double x = relativeX(_startX[ID], domain.centre);
+	const bool owned = (_owner[ID] == domain.index);
+	if (!owned && (std::abs(x) >= reach)) continue;
+
+	if (owned) _ownerIndex[ID] = sub.particles.size();
+
+	Vector pos = part.getPosition();
+	pos[0] = x;
+	sub.particles.push_back(Particle(pos, part.getVelocity(), sub.particles.size()));
+	if (!part.testState(Particle::DYNAMIC))
+	  sub.particles.back().clearState(Particle::DYNAMIC);
+
+	domain.globalID.push_back(ID);
+	domain.offset.push_back(_startX[ID] - x);
+	domain.startX.push_back(x);
+      }
+  }
+
+  void
+  EParallelDomainSimulation::runDomain(Domain& domain, const double dt)
+  {
+    loadDomain(domain);
+    executeDomain(domain, dt);
+  }
+
+  void
+  EParallelDomainSimulation::executeDomain(Domain& domain, const double dt)
+  {
+    Simulation& sub = domain.sim;
+    const size_t N = sub.particles.size();
+    domain.minDisp.assign(N, 0);
+    domain.maxDisp.assign(N, 0);
+    domain.eventCounts.assign(N, 0);
+    domain.finalPositions.resize(N);
+    domain.finalVelocities.resize(N);
+    domain.events.clear();
+
+    sub.systemTime = simulation.systemTime;
+    sub.eventCount = 0;
+    sub.endEventCount = std::numeric_limits<size_t>::max();
+    domain.halt->setdt(dt / sub.units.unitTime());
+    domain.recorder->reset();
+
+    //This also rebuilds the event list of the sub-simulation
+    domain.nblist->reinitialise();
+
+    while (sub.runSimulationStep(true)) {}
+
+    sub.dynamics->updateAllParticles();
+    for (const Particle& part : sub.particles)
+      {
+	const size_t ID = part.getID();
+	Vector pos = part.getPosition();
+	const double disp = pos[0] - domain.startX[ID];
+	domain.minDisp[ID] = std::min(domain.minDisp[ID], disp);
+	domain.maxDisp[ID] = std::max(domain.maxDisp[ID], disp);
+	pos[0] += domain.offset[ID];
+	domain.finalPositions[ID] = pos;
+	domain.finalVelocities[ID] = part.getVelocity();
+      }
+  }
+
+  bool
+  EParallelDomainSimulation::testConflicts(const Domain& domain) const
+  {
+    const double posTol = trajectoryTolerance * simulation.units.unitLength();
+    const double velTol = trajectoryTolerance * simulation.units.unitVelocity();
+
+    //The range of x coordinates which can interact with the owned
+    //particles over the window
+    double extentMin = std::numeric_limits<double>::infinity();
+    double extentMax = -std::numeric_limits<double>::infinity();
+    for (size_t i(0); i < domain.globalID.size(); ++i)
+      if (_owner[domain.globalID[i]] == domain.index)
+	{
+	  extentMin = std::min(extentMin, domain.startX[i] + domain.minDisp[i]);
+	  extentMax = std::max(extentMax, domain.startX[i] + domain.maxDisp[i]);
+	}
+    extentMin -= _interactionRange;
+    extentMax += _interactionRange;
+
+    size_t next = 0;
+    for (size_t ID(0); ID < simulation.N(); ++ID)
+      {
+	const bool present = (next < domain.globalID.size()) && (domain.globalID[next] == ID);
+	const size_t i = present ? next++ : 0;
+
+	if (_owner[ID] == domain.index) continue;
+
+	//The true trajectory of the particle, from its owning domain
+	const Domain& owner = *_domains[_owner[ID]];
+	const size_t oi = _ownerIndex[ID];
+	const double x = relativeX(_startX[ID], domain.centre);
+	const bool reaches = (x + owner.maxDisp[oi] > extentMin) && (x + owner.minDisp[oi] < extentMax);
+
+	if (!present)
+	  {
+	    if (reaches) return true;
+	    continue;
+	  }
+
+	//A halo particle which followed its true trajectory
+	if ((domain.eventCounts[i] == owner.eventCounts[oi])
+	    && ((domain.finalPositions[i] - owner.finalPositions[oi]).nrm() < posTol)
+	    && ((domain.finalVelocities[i] - owner.finalVelocities[oi]).nrm() < velTol))
+	  continue;
+
+	if (reaches || ((x + domain.maxDisp[i] > extentMin) && (x + domain.minDisp[i] < extentMax)))
+	  return true;
+      }
+
+    return false;
+  }
+
+  void
+  EParallelDomainSimulation::streamSimulation(const double dt)
+  {
+    simulation.systemTime += dt;
+    simulation.stream(dt);
+  }
+
+  bool
+  EParallelDomainSimulation::runSystemEvents(const double time)
+  {
+    while (true)
+      {
+	shared_ptr<System> next;
+	for (const shared_ptr<System>& system : simulation.systems)
+	  if (!next || (system->getdt() < next->getdt()))
+	    next = system;
+
+	if (!next) return true;
+
+	const double dt = std::max(next->getdt(), 0.0);
+	if (simulation.systemTime + dt > time) return true;
+
+	streamSimulation(dt);
+	const NEventData data = next->runEvent();
+	if (!data.L1partChanges.empty() || !data.L2partChanges.empty())
+	  M_throw() << "The System \"" << next->getName() << "\" altered particles, which is not supported by the parallel domain engine";
+
+	if (simulation.eventCount >= simulation.endEventCount) return false;
+      }
+  }
+
+  bool
+  EParallelDomainSimulation::commitWindow(const double endTime)
+  {
+    std::vector<const Domain::EventRecord*> events;
+    for (const std::unique_ptr<Domain>& domain : _domains)
+      for (const Domain::EventRecord& record : domain->events)
+	events.push_back(&record);
+
+    std::stable_sort(events.begin(), events.end(),
+		     [](const Domain::EventRecord* a, const Domain::EventRecord* b) { return a->time < b->time; });
+
+    //The events are replayed as the scheduler would run them, so
+    //that the OutputPlugin's (and System's) see every event in order.
+    for (const Domain::EventRecord* record : events)
+      {
+	if (!runSystemEvents(record->time)) return false;
+
+	Event event(record->event);
+	event._dt = record->time - simulation.systemTime;
+	streamSimulation(event._dt);
+
+	for (const Domain::ParticleState& state : record->states)
+	  {
+	    Particle& part = simulation.particles[state.ID];
+	    simulation.dynamics->updateParticle(part);
+	    part.getPosition() = state.position;
+	    part.getVelocity() = state.velocity;
+	  }
+
+	if (record->counted) ++simulation.eventCount;
+
+	simulation._sigParticleUpdate(record->data);
+	simulation.ptrScheduler->outputEventUpdate(event, record->data);
+
+	if (simulation.eventCount >= simulation.endEventCount) return false;
+      }
+
+    if (!runSystemEvents(endTime)) return false;
+    streamSimulation(endTime - simulation.systemTime);
+
+    //Copy the final states from the owning domains
+    for (Particle& part : simulation.particles)
+      {
+	const Domain& owner = *_domains[_owner[part.getID()]];
+	const size_t oi = _ownerIndex[part.getID()];
+	simulation.dynamics->updateParticle(part);
+	part.getPosition() = owner.finalPositions[oi];
+	part.getVelocity() = owner.finalVelocities[oi];
+      }
+
+    return true;
+  }
+
+  void
+  EParallelDomainSimulation::runDomains(const double dt)
+  {
+    SuppressOutput quiet;
+    std::vector<std::function<void()> > tasks;
+    for (const std::unique_ptr<Domain>& domain : _domains)
+      tasks.push_back(std::bind(&EParallelDomainSimulation::runDomain, this, std::ref(*domain), dt));
+    threads.queueTasks(tasks);
+    threads.wait();
+  }
+
+  bool
+  EParallelDomainSimulation::runWindow(const double dt)
+  {
+    updateOwners();
+    const double endTime = simulation.systemTime + dt;
+
+    runDomains(dt);
+
+    std::vector<char> conflicts(_domains.size(), false);
+    {
+      std::vector<std::function<void()> > tasks;
+      for (size_t i(0); i < _domains.size(); ++i)
+	tasks.push_back([this, &conflicts, i]() { conflicts[i] = testConflicts(*_domains[i]); });
+      threads.queueTasks(tasks);
+      threads.wait();
+    }
+
+    if (std::find(conflicts.begin(), conflicts.end(), true) != conflicts.end())
+      {
+	++_rolledBackWindows;
+	return false;
+      }
+
+    //A partially committed window would leave the remaining events
+    //of the domains unapplied, so a window which reaches the end of
+    //the run is discarded and the remaining events run serially.
+    size_t windowEvents = 0;
+    for (const std::unique_ptr<Domain>& domain : _domains)
+      for (const Domain::EventRecord& record : domain->events)
+	windowEvents += record.counted;
+
+    if (simulation.eventCount + windowEvents >= simulation.endEventCount)
+      {
+	runSerial(simulation.endEventCount - simulation.eventCount);
+	return true;
+      }
+
+    ++_committedWindows;
+    _schedulerStale = true;
+    if (!commitWindow(endTime))
+      //A System halted the main Simulation part way through the
+      //window. The particles are left in their states at the halt,
+      //as the later events of the window were never applied.
+      std::cout << "Parallel domain engine: the simulation halted during a window" << std::endl;
+
+    return true;
+  }
+
+  void
+  EParallelDomainSimulation::rebuildScheduler()
+  {
+    if (!_schedulerStale) return;
+
+    //This also rebuilds the event list of the main Simulation
+    std::dynamic_pointer_cast<GNeighbourList>(simulation.globals["SchedulerNBList"])->reinitialise();
+    _schedulerStale = false;
+  }
+
+  void
+  EParallelDomainSimulation::runSerial(const size_t events)
+  {
+    rebuildScheduler();
+
+    const size_t startEvents = simulation.eventCount;
+    while ((simulation.eventCount < startEvents + events) && simulation.runSimulationStep())
+      handleSignals();
+
+    _serialEvents += simulation.eventCount - startEvents;
+  }
+
+  void
+  EParallelDomainSimulation::runEvents()
+  {
+    if (_baseWindow <= 0)
+      {
+	//Estimate the mean free time from a serial run
+	const double startTime = simulation.systemTime;
+	const size_t startEvents = simulation.eventCount;
+	runSerial(simulation.N());
+	const size_t events = simulation.eventCount - startEvents;
+	if (!events) return;
+
+	_baseWindow = _window = vm["domain-window"].as<double>()
+	  * (simulation.systemTime - startTime) * simulation.N() / (2.0 * events);
+      }
+
+    size_t rollbacks = 0;
+    while (simulation.eventCount < simulation.endEventCount)
+      {
+	if (rollbacks == maxRollbacks)
+	  {
+	    runSerial(_serialRunLength);
+	    rollbacks = 0;
+	  }
+	else if (runWindow(_window))
+	  {
+	    rollbacks = 0;
+	    _window = std::min(_window * windowGrowth, maxWindowFactor * _baseWindow);
+	  }
+	else
+	  {
+	    ++rollbacks;
+	    _window *= 0.5;
+	  }
+
+	if ((simulation.eventCount >= _nextPrint) && simulation.outputPlugins.size())
+	  {
+	    for (shared_ptr<OutputPlugin>& plugin : simulation.outputPlugins)
+	      plugin->periodicOutput();
+
+	    _nextPrint = simulation.eventCount + simulation.eventPrintInterval;
+	    std::cout << std::endl;
+	  }
+
+	handleSignals();
+      }
+
+    //Leave the main Simulation ready to run further events
+    rebuildScheduler();
+
+    std::cout << "Parallel domain engine: " << _committedWindows << " windows committed, "
+	      << _rolledBackWindows << " rolled back, " << _serialEvents << " events executed serially"
+	      << std::endl;
+  }
+}
@@ -0,0 +1,271 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file parallel.hpp
+ * \brief Contains the definition of EParallelDomainSimulation.
+ */
+
+#pragma once
+#include <dynamo/coordinator/engine/single.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace dynamo {
+  class SystHalt;
+  class GNeighbourList;
+
+  /*! \brief An Engine which executes the events of a single large
+   * system concurrently, by splitting it into spatial domains.
+   *
+   * The primary image is divided into slabs along the x axis. The
+   * events of each slab are speculatively executed over a window of
+   * time in a separate Simulation (on the thread pool), which also
+   * contains the particles in a "halo" around the slab, so that the
+   * collisions across the slab boundaries can be executed.
+   *
+   * At the end of a window, the trajectories are validated. The halo
+   * particles of a domain might not follow their true trajectories,
+   * as their neighbours outside the halo are missing. A window is
+   * only accepted if
+   * - every halo particle which disagrees with its owning domain
+   *   (by its event count or final state) stays away from the
+   *   particles owned by the domain, and
+   * - no particle missing from a domain came within range of the
+   *   particles owned by the domain.
+   *
+   * Under these conditions, every owned particle was only influenced
+   * by particles following their true trajectories, so the results
+   * are the same as those of the serial ESingleSimulation. An
+   * accepted window is committed by replaying its events, in time
+   * order, through the OutputPlugin's and System's of the main
+   * Simulation. A rejected window is rolled back (it has not altered
+   * the main Simulation) and retried with a shorter window; if the
+   * rollbacks persist, some events are executed serially instead.
+   *
+   * The window length adapts to the rollback rate, starting from a
+   * multiple of the mean free time. The sub-simulations are only
+   * periodic in the y and z directions, so that their neighbour lists
+   * are sized for the density of the system.
+   *
+   * This engine only supports a restricted set of systems:
+   * Newtonian dynamics without orientation data in periodic boundary
+   * conditions, with interactions and species covering all particles,
+   * no per-particle properties, Locals, Topology, captured-pair state
+   * or System events other than tickers, snapshots and halts.
+   */
+  class EParallelDomainSimulation: public ESingleSimulation
+  {
+  public:
+    /*! \brief The only constructor.
+     *
+     * \param vm The parsed command line options.
+     * \param tp The shared thread pool.
+     */
+    EParallelDomainSimulation(const boost::program_options::variables_map& vm,
+			      magnet::thread::ThreadPool& tp);
+
+    virtual ~EParallelDomainSimulation();
+
+    /*! \brief The options specific to the EParallelDomainSimulation
+     * class.
+     *
+     * This is used by the Coordinator::parseOptions function.
+     *
+     * \param od The options description to add the options to.
+     */
+    static void getOptions(boost::program_options::options_description& od);
+
+    //! \brief The number of windows which have been committed.
+    size_t getCommittedWindows() const { return _committedWindows; }
+
+    //! \brief The number of windows which have been rolled back.
+    size_t getRolledBackWindows() const { return _rolledBackWindows; }
+
+    //! \brief The number of events executed serially.
+    size_t getSerialEvents() const { return _serialEvents; }
+
+  protected:
+    struct DomainRecorder;
+
+    /*! \brief A spatial domain and the Simulation executing its events.
+     */
+    struct Domain
+    {
+      //! \brief The state of a particle after an event.
+      struct ParticleState
+      {
+	ParticleState() {}
+
+	ParticleState(size_t nID, const Vector& pos, const Vector& vel):
+	  ID(nID), position(pos), velocity(vel) {}
+
+	size_t ID;
+	Vector position;
+	Vector velocity;
+      };
+
+      //! \brief An event executed by a domain, using the particle IDs
+      //! of the main Simulation.
+      struct EventRecord
+      {
+	double time;
+	Event event;
+	NEventData data;
+	//! \brief If the event is counted in Simulation::eventCount.
+	bool counted;
+	std::vector<ParticleState> states;
+      };
+
+      Domain(size_t nIndex, double nCentre):
+	index(nIndex), centre(nCentre)
+      {}
+
+      size_t index;
+      //! \brief The x coordinate of the centre of the slab.
+      double centre;
+
+      Simulation sim;
+      shared_ptr<SystHalt> halt;
+      shared_ptr<DomainRecorder> recorder;
+      shared_ptr<GNeighbourList> nblist;
+
+      //! \brief The ID of each particle in the main Simulation (sorted).
+      std::vector<size_t> globalID;
+      //! \brief The x offset from the domain to the main Simulation.
+      std::vector<double> offset;
+      //! \brief The initial x coordinate of each particle in the domain.
+      std::vector<double> startX;
+      //! \brief The range of x displacements of each particle.
+      std::vector<double> minDisp, maxDisp;
+      //! \brief The number of non-virtual events of each particle.
+      std::vector<size_t> eventCounts;
+      //! \brief The final states (in the frame of the main Simulation).
+      std::vector<Vector> finalPositions, finalVelocities;
+
+      //! \brief The events owned by this domain, in time order.
+      std::vector<EventRecord> events;
+    };
+
+    /*! \brief Checks the Simulation is supported and builds the
+     * domain Simulation's.
+     */
+    virtual void postSimInit(Simulation&);
+
+    /*! \brief Runs windows until the Simulation halts.
+     */
+    virtual void runEvents();
+
+    /*! \brief Speculatively executes a window of the given length
+     * and commits it if it is valid.
+     *
+     * \return false if the window was rolled back.
+     */
+    bool runWindow(double dt);
+
+    /*! \brief Copies the particles around a domain from the main
+     * Simulation into its sub-simulation.
+     */
+    void loadDomain(Domain&);
+
+    //! \brief Executes a window of events in the sub-simulation of a domain.
+    void runDomain(Domain&, double dt);
+
+    /*! \brief Executes a window of events in the sub-simulation of
+     * an already loaded domain.
+     */
+    void executeDomain(Domain&, double dt);
+
+    /*! \brief Executes a window of the given length in every domain.
+     *
+     * The domains are run concurrently on the thread pool.
+     */
+    virtual void runDomains(double dt);
+
+    /*! \brief Tests if the window executed by a domain is
+     * consistent with the other domains.
+     *
+     * \return true if the window must be rolled back.
+     */
+    bool testConflicts(const Domain&) const;
+
+    /*! \brief Replays the events of an accepted window through the
+     * main Simulation.
+     *
+     * \return false if the main Simulation halted during the window.
+     */
+    bool commitWindow(double endTime);
+
+    /*! \brief Runs the System events of the main Simulation which
+     * occur before the passed time.
+     *
+     * \return false if the main Simulation halted.
+     */
+    bool runSystemEvents(double time);
+
+    //! \brief Moves the main Simulation forward in time.
+    void streamSimulation(double dt);
+
+    /*! \brief Updates the domain owning each particle, from the
+     * current positions of the particles in the main Simulation.
+     */
+    void updateOwners();
+
+    //! \brief Executes events in the main Simulation serially.
+    void runSerial(size_t events);
+
+    /*! \brief Rebuilds the neighbour list and event list of the main
+     * Simulation, if windows have been committed since they were
+     * last built.
+     */
+    void rebuildScheduler();
+
+    //! \brief Returns the x coordinate relative to the centre of a
+    //! domain, in the primary image.
+    double relativeX(double x, double centre) const
+    {
+      x -= centre;
+      return x - _boxLength * std::round(x / _boxLength);
+    }
+
+    std::vector<std::unique_ptr<Domain> > _domains;
+
+    //! \brief The domain owning each particle in the current window.
+    std::vector<size_t> _owner;
+    //! \brief The index of each particle in its owning domain.
+    std::vector<size_t> _ownerIndex;
+    //! \brief The x coordinate of each particle at the start of the window.
+    std::vector<double> _startX;
+
+    double _boxLength;
+    double _slabWidth;
+    double _halo;
+    double _interactionRange;
+
+    //! \brief The initial window length.
+    double _baseWindow;
+    double _window;
+    size_t _serialRunLength;
+    //! \brief If the scheduler of the main Simulation is out of date.
+    bool _schedulerStale;
+    size_t _nextPrint;
+
+    size_t _committedWindows;
+    size_t _rolledBackWindows;
+    size_t _serialEvents;
+  };
+}
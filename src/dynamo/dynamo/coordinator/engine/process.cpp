@@ -0,0 +1,274 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/coordinator/engine/process.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <typeinfo>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace dynamo {
+  namespace {
+    //! \brief The capacity (in bytes) of each SharedRingBuffer.
+    const size_t bufferCapacity = 1 << 22;
+  }
+
+  EProcessDomainSimulation::EProcessDomainSimulation(const boost::program_options::variables_map& nVM,
+						     magnet::thread::ThreadPool& tp):
+    EParallelDomainSimulation(nVM, tp)
+  {}
+
+  EProcessDomainSimulation::~EProcessDomainSimulation()
+  {
+    //The workers hold no state which must be saved, so they are
+    //simply killed (they may be blocked mid-window if an exception
+    //was thrown).
+    for (const std::unique_ptr<Worker>& worker : _workers)
+      if (worker->pid > 0)
+	{
+	  kill(worker->pid, SIGKILL);
+	  waitpid(worker->pid, NULL, 0);
+	}
+  }
+
+  void
+  EProcessDomainSimulation::postSimInit(Simulation& sim)
+  {
+    EParallelDomainSimulation::postSimInit(sim);
+
+    //Only the forking thread survives in the workers, so no other
+    //threads (which may hold locks, e.g., of the allocator) may be
+    //running at the fork.
+    for (const shared_ptr<OutputPlugin>& plugin : sim.outputPlugins)
+      {
+	const shared_ptr<OPTicker> ticker = std::dynamic_pointer_cast<OPTicker>(plugin);
+	if (ticker && ticker->backgroundAnalysis())
+	  M_throw() << "The multi-process domain engine does not support background analysis in the OutputPlugin \""
+		    << typeid(*plugin).name() << "\"";
+      }
+
+    const size_t threadCount = threads.getThreadCount();
+    threads.setThreadCount(0);
+
+    //The buffers must be mapped before forking, so that they are
+    //shared by the workers.
+    for (size_t i(0); i < _domains.size(); ++i)
+      _workers.push_back(std::unique_ptr<Worker>(new Worker(bufferCapacity)));
+
+    //Don't let the workers inherit any buffered output
+    std::cout.flush();
+    std::cerr.flush();
+
+    for (size_t i(0); i < _domains.size(); ++i)
+      {
+	Worker& worker = *_workers[i];
+	const pid_t pid = fork();
+
+	if (pid < 0)
+	  M_throw() << "Failed to fork a worker process: " << std::strerror(errno);
+
+	if (!pid)
+	  {
+	    //The worker never returns from here, and must not run the
+	    //destructors of the main process (e.g., the thread pool).
+	    std::cout.setstate(std::ios::failbit);
+	    try {
+	      workerLoop(*_domains[i], worker);
+	    } catch (std::exception& cep)
+	      {
+		std::cerr << "\nWorker process of domain " << i << " failed:\n" << cep.what() << std::endl;
+		_exit(EXIT_FAILURE);
+	      }
+	    _exit(EXIT_SUCCESS);
+	  }
+
+	worker.pid = pid;
+	const std::function<void()> checkWorker = [pid]() {
+	  int status;
+	  if (waitpid(pid, &status, WNOHANG) == pid)
+	    M_throw() << "A worker process of the multi-process domain engine has terminated";
+	};
+	worker.toWorker.setIdleFunction(checkWorker);
+	worker.fromWorker.setIdleFunction(checkWorker);
+      }
+
+    //The thread pool is still used by the main process to test the
+    //windows for conflicts
+    threads.setThreadCount(threadCount);
+
+    std::cout << "Multi-process domain engine: forked " << _workers.size() << " worker processes" << std::endl;
+  }
+
+  void
+  EProcessDomainSimulation::runDomains(const double dt)
+  {
+    //All domains are sent first, so the workers run concurrently
+    for (size_t i(0); i < _domains.size(); ++i)
+      {
+	loadDomain(*_domains[i]);
+	_workers[i]->toWorker.send(char(true));
+	_workers[i]->toWorker.send(dt);
+	sendDomain(*_domains[i], *_workers[i]);
+      }
+
+    for (size_t i(0); i < _domains.size(); ++i)
+      receiveResults(*_domains[i], *_workers[i]);
+  }
+
+  void
+  EProcessDomainSimulation::sendDomain(const Domain& domain, Worker& worker)
+  {
+    const std::vector<Particle>& particles = domain.sim.particles;
+    std::vector<Vector> positions, velocities;
+    std::vector<char> dynamic, owned;
+    positions.reserve(particles.size());
+    velocities.reserve(particles.size());
+    for (size_t i(0); i < particles.size(); ++i)
+      {
+	positions.push_back(particles[i].getPosition());
+	velocities.push_back(particles[i].getVelocity());
+	dynamic.push_back(particles[i].testState(Particle::DYNAMIC));
+	owned.push_back(_owner[domain.globalID[i]] == domain.index);
+      }
+
+    magnet::thread::SharedRingBuffer& buffer = worker.toWorker;
+    buffer.send(simulation.systemTime);
+    buffer.send(positions);
+    buffer.send(velocities);
+    buffer.send(dynamic);
+    buffer.send(owned);
+    buffer.send(domain.globalID);
+    buffer.send(domain.offset);
+    buffer.send(domain.startX);
+  }
+
+  void
+  EProcessDomainSimulation::receiveResults(Domain& domain, Worker& worker)
+  {
+    magnet::thread::SharedRingBuffer& buffer = worker.fromWorker;
+    if (!buffer.receive<char>())
+      {
+	std::string error;
+	buffer.receive(error);
+	M_throw() << "The worker process of domain " << domain.index << " failed:\n" << error;
+      }
+
+    buffer.receive(domain.minDisp);
+    buffer.receive(domain.maxDisp);
+    buffer.receive(domain.eventCounts);
+    buffer.receive(domain.finalPositions);
+    buffer.receive(domain.finalVelocities);
+
+    domain.events.clear();
+    const size_t count = buffer.receive<size_t>();
+    domain.events.reserve(count);
+    for (size_t i(0); i < count; ++i)
+      {
+	domain.events.push_back(Domain::EventRecord());
+	Domain::EventRecord& record = domain.events.back();
+	buffer.receive(record.time);
+	buffer.receive(record.event);
+	record.counted = buffer.receive<char>();
+
+	std::vector<ParticleEventData> L1;
+	buffer.receive(L1);
+	record.data.L1partChanges.assign(L1.begin(), L1.end());
+
+	std::vector<PairEventData> L2;
+	buffer.receive(L2);
+	record.data.L2partChanges.assign(L2.begin(), L2.end());
+
+	buffer.receive(record.states);
+      }
+  }
+
+  void
+  EProcessDomainSimulation::workerLoop(Domain& domain, Worker& worker)
+  {
+    //Exit if the main process terminates
+    const pid_t parent = getppid();
+    const std::function<void()> checkParent = [parent]() { if (getppid() != parent) _exit(EXIT_FAILURE); };
+    worker.toWorker.setIdleFunction(checkParent);
+    worker.fromWorker.setIdleFunction(checkParent);
+
+    Simulation& sub = domain.sim;
+    magnet::thread::SharedRingBuffer& input = worker.toWorker;
+    magnet::thread::SharedRingBuffer& output = worker.fromWorker;
+    while (input.receive<char>())
+      {
+	const double dt = input.receive<double>();
+	input.receive(simulation.systemTime);
+
+	std::vector<Vector> positions, velocities;
+	std::vector<char> dynamic, owned;
+	input.receive(positions);
+	input.receive(velocities);
+	input.receive(dynamic);
+	input.receive(owned);
+	input.receive(domain.globalID);
+	input.receive(domain.offset);
+	input.receive(domain.startX);
+
+	//This also zeroes the peculiar time of the Dynamics, so the
+	//new particles are up to date.
+	sub.dynamics->updateAllParticles();
+	sub.particles.clear();
+	for (size_t i(0); i < positions.size(); ++i)
+	  {
+	    sub.particles.push_back(Particle(positions[i], velocities[i], i));
+	    if (!dynamic[i])
+	      sub.particles.back().clearState(Particle::DYNAMIC);
+
+	    //Only the owned particles of this domain are needed by the
+	    //DomainRecorder
+	    _owner[domain.globalID[i]] = owned[i] ? domain.index : _domains.size();
+	  }
+
+	try {
+	  executeDomain(domain, dt);
+	} catch (std::exception& cep)
+	  {
+	    output.send(char(false));
+	    output.send(std::string(cep.what()));
+	    continue;
+	  }
+
+	output.send(char(true));
+	output.send(domain.minDisp);
+	output.send(domain.maxDisp);
+	output.send(domain.eventCounts);
+	output.send(domain.finalPositions);
+	output.send(domain.finalVelocities);
+
+	output.send(domain.events.size());
+	for (const Domain::EventRecord& record : domain.events)
+	  {
+	    output.send(record.time);
+	    output.send(record.event);
+	    output.send(char(record.counted));
+	    output.send(std::vector<ParticleEventData>(record.data.L1partChanges.begin(), record.data.L1partChanges.end()));
+	    output.send(std::vector<PairEventData>(record.data.L2partChanges.begin(), record.data.L2partChanges.end()));
+	    output.send(record.states);
+	  }
+      }
+  }
+}
@@ -0,0 +1,99 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file process.hpp
+ * \brief Contains the definition of EProcessDomainSimulation.
+ */
+
+#pragma once
+#include <dynamo/coordinator/engine/parallel.hpp>
+#include <magnet/thread/sharedringbuffer.hpp>
+#include <sys/types.h>
+
+namespace dynamo {
+  /*! \brief A variant of the EParallelDomainSimulation which
+   * executes each domain in a separate worker process.
+   *
+   * The worker processes are forked once the domains have been
+   * built, so the execution of a window in a worker does not
+   * contend for the allocator of the main process. The thread pool
+   * is stopped while forking (and background analysis is refused),
+   * as only the forking thread survives in a worker.
+   *
+   * The communication uses a star topology: the main process holds
+   * the state of every particle, and rebuilds the particles of each
+   * domain (including its halo) at the start of every window. These
+   * are sent to the worker, and the resulting events and
+   * trajectories are returned, through a pair of SharedRingBuffer's.
+   * There is no exchange of halos between the workers, so this
+   * engine only moves the execution of the domains out of the main
+   * process; it does not distribute the memory of the simulation.
+   *
+   * The validation, commit and rollback of the windows (and the
+   * final state written by Simulation::writeXMLfile) are handled by
+   * the main process exactly as in the EParallelDomainSimulation.
+   */
+  class EProcessDomainSimulation: public EParallelDomainSimulation
+  {
+  public:
+    /*! \brief The only constructor.
+     *
+     * \param vm The parsed command line options.
+     * \param tp The shared thread pool.
+     */
+    EProcessDomainSimulation(const boost::program_options::variables_map& vm,
+			     magnet::thread::ThreadPool& tp);
+
+    /*! \brief Terminates the worker processes.
+     */
+    virtual ~EProcessDomainSimulation();
+
+  protected:
+    //! \brief A worker process and its communication channels.
+    struct Worker
+    {
+      Worker(size_t capacity):
+	toWorker(capacity), fromWorker(capacity), pid(0) {}
+
+      magnet::thread::SharedRingBuffer toWorker;
+      magnet::thread::SharedRingBuffer fromWorker;
+      pid_t pid;
+    };
+
+    /*! \brief Builds the domains and forks a worker process for
+     * each of them.
+     */
+    virtual void postSimInit(Simulation&);
+
+    /*! \brief Sends every domain to its worker and collects the
+     * results.
+     */
+    virtual void runDomains(double dt);
+
+    /*! \brief The main loop of a worker process, which executes
+     * windows of its domain until it is stopped.
+     */
+    void workerLoop(Domain&, Worker&);
+
+    //! \brief Sends the loaded particles of a domain to its worker.
+    void sendDomain(const Domain&, Worker&);
+
+    //! \brief Receives the results of a window from a worker.
+    void receiveResults(Domain&, Worker&);
+
+    std::vector<std::unique_ptr<Worker> > _workers;
+  };
+}
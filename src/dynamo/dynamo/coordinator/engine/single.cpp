@@ -31,42 +31,7 @@ namespace dynamo {
   ESingleSimulation::runSimulation()
   {
     try {
-      while (true)
-	{
-	  if (!simulation.runSimulationStep()) break;
-	  if (_SIGINT)
-	    {
-	      //Clear the writes to screen
-	      std::cout.flush();
-	      std::cerr << "\n<S>hutdown or <P>eek at data output:";
-	      
-	      char c;
-	      //Clear the input buffer
-	      std::cin.clear();
-	      setvbuf(stdin, NULL, _IONBF, 0);
-	      c=getchar();
-	      setvbuf(stdin, NULL, _IOLBF, BUFSIZ);
-	      switch (c)
-		{
-		case 's':
-		case 'S':
-		  simulation.simShutdown();
-		  break;
-		case 'p':
-		case 'P':
-		  simulation.outputData("peek.data.xml.bz2");
-		  break;
-		}	      
-
-	      _SIGINT = false;
-	      Coordinator::setup_signal_handler();
-	    }
-	  if (_SIGTERM)
-	    {
-	      _SIGTERM=false;
-	      simulation.simShutdown();
-	    }
-	}
+      runEvents();
     }
     catch (std::exception& cep)
       {
@@ -82,6 +47,50 @@ namespace dynamo {
       }
   }
 
+  void
+  ESingleSimulation::runEvents()
+  {
+    while (simulation.runSimulationStep())
+      handleSignals();
+  }
+
+  void
+  ESingleSimulation::handleSignals()
+  {
+    if (_SIGINT)
+      {
+	//Clear the writes to screen
+	std::cout.flush();
+	std::cerr << "\n<S>hutdown or <P>eek at data output:";
+	
+	char c;
+	//Clear the input buffer
+	std::cin.clear();
+	setvbuf(stdin, NULL, _IONBF, 0);
+	c=getchar();
+	setvbuf(stdin, NULL, _IOLBF, BUFSIZ);
+	switch (c)
+	  {
+	  case 's':
+	  case 'S':
+	    simulation.simShutdown();
+	    break;
+	  case 'p':
+	  case 'P':
+	    simulation.outputData("peek.data.xml.bz2");
+	    break;
+	  }	      
+
+	_SIGINT = false;
+	Coordinator::setup_signal_handler();
+      }
+    if (_SIGTERM)
+      {
+	_SIGTERM=false;
+	simulation.simShutdown();
+      }
+  }
+
   void
   ESingleSimulation::initialisation()
   {
@@ -62,6 +62,18 @@ namespace dynamo {
     virtual void initialisation();
 
   protected:
+    /*! \brief Executes the events of the Simulation until it halts.
+     *
+     * This is called by runSimulation(), which also handles any
+     * exceptions thrown.
+     */
+    virtual void runEvents();
+
+    /*! \brief Processes any SIGINT (peek/shutdown) or SIGTERM
+     * received since the last call.
+     */
+    void handleSignals();
+
     /*! \brief The single instance of a Simulation required.
      */
     Simulation simulation;
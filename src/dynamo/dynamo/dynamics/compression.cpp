@@ -225,13 +225,12 @@ namespace dynamo {
  
     double mass = Sim->species[tmpDat.getSpeciesID()]->getMass(part.getID());
 
-    std::normal_distribution<> normal_dist;
-    std::uniform_real_distribution<> uniform_dist;
-
+    magnet::math::Philox rng = Sim->getRandomStream(part.getID(), Sim->eventCount);
     if (slip != 1) {
-      std::normal_distribution<> norm_dist;
+      double normals[NDIM];
+      rng.normal(normals, NDIM);
       for (size_t iDim = 0; iDim < NDIM; iDim++)
-	part.getVelocity()[iDim] = (1-slip) * norm_dist(Sim->ranGenerator) * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
+	part.getVelocity()[iDim] = (1-slip) * normals[iDim] * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
     }
 
 
@@ -239,7 +238,7 @@ namespace dynamo {
 
     part.getVelocity()
       //This first line adds a component in the direction of the normal
-      += vNorm * (sqrtT * sqrt(-2.0*log(1.0 - uniform_dist(Sim->ranGenerator)) / mass)
+      += vNorm * (sqrtT * sqrt(-2.0*log(rng.uniform()) / mass)
 		  //This removes the original normal component
 		  - (vij | vNorm))
       ;
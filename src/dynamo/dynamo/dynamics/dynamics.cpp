@@ -22,9 +22,43 @@
 #include <dynamo/units/units.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <algorithm>
+#include <functional>
+#include <thread>
 #include <cstring>
+#include <cmath>
 
 namespace dynamo {
+  namespace {
+    //! \brief The number of particles in each chunk of the ParticleData.
+    const size_t particleChunkSize = 4096;
+
+    /*! \brief Calls the passed function for each chunk of N
+        particles, with the chunk index and the range of particle
+        indices [begin, end).
+
+	The chunks are processed concurrently if there is more than
+	one chunk and more than one core.
+    */
+    void forEachParticleChunk(const size_t N, const std::function<void(size_t, size_t, size_t)>& func)
+    {
+      const size_t chunks = (N + particleChunkSize - 1) / particleChunkSize;
+      const size_t threadCount = std::min(chunks, size_t(std::thread::hardware_concurrency()));
+
+      //A pool without threads executes the tasks in wait()
+      magnet::thread::ThreadPool pool;
+      if (threadCount > 1)
+	pool.setThreadCount(threadCount);
+
+      std::vector<std::function<void()> > tasks;
+      for (size_t chunk(0); chunk < chunks; ++chunk)
+	tasks.push_back(std::bind(func, chunk, chunk * particleChunkSize, std::min(N, (chunk + 1) * particleChunkSize)));
+      pool.queueTasks(tasks);
+      pool.wait();
+    }
+  }
+
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const Dynamics& g)
   {
     g.outputXML(XML);
@@ -108,43 +142,60 @@ namespace dynamo {
   {
     dout << "Loading Particle Data" << std::endl;
 
-    bool outofsequence = false;  
-  
+    //The document is walked once to find the nodes, which are then
+    //converted in parallel chunks.
+    std::vector<magnet::xml::Node> nodes;
     for (magnet::xml::Node node = XML.getNode("ParticleData").findNode("Pt"); 
 	 node.valid(); ++node)
-      {
-	if (!node.hasAttribute("ID")
-	    || node.getAttribute("ID").as<size_t>() != Sim->particles.size())
-	  outofsequence = true;
-      
-	Particle part(node, Sim->particles.size());
-	part.getVelocity() *= Sim->units.unitVelocity();
-	part.getPosition() *= Sim->units.unitLength();
-	Sim->particles.push_back(part);
-      }
+      nodes.push_back(node);
+
+    const bool loadOrientation = XML.getNode("ParticleData").hasAttribute("OrientationData");
+    const size_t firstID = Sim->particles.size();
+    const double unitVelocity = Sim->units.unitVelocity();
+    const double unitLength = Sim->units.unitLength();
+    const size_t chunks = (nodes.size() + particleChunkSize - 1) / particleChunkSize;
+    std::vector<std::vector<Particle> > chunkParticles(chunks);
+    std::vector<char> chunkOutOfSequence(chunks, false);
+    if (loadOrientation)
+      orientationData.resize(firstID + nodes.size());
+
+    forEachParticleChunk(nodes.size(), [&](const size_t chunk, const size_t begin, const size_t end) {
+	std::vector<Particle>& particles = chunkParticles[chunk];
+	particles.reserve(end - begin);
+	for (size_t i(begin); i < end; ++i)
+	  {
+	    const magnet::xml::Node& node = nodes[i];
+	    if (!node.hasAttribute("ID")
+		|| node.getAttribute("ID").as<size_t>() != firstID + i)
+	      chunkOutOfSequence[chunk] = true;
+
+	    particles.push_back(Particle(node, firstID + i));
+	    particles.back().getVelocity() *= unitVelocity;
+	    particles.back().getPosition() *= unitLength;
+
+	    if (loadOrientation)
+	      {
+		orientationData[i].orientation << node.getNode("U");
+		orientationData[i].angularVelocity << node.getNode("O");
+
+		//Makes the vector a unit vector
+		orientationData[i].orientation.normalise();
+		if (orientationData[i].orientation.nrm() == 0)
+		  M_throw() << "Particle " << i << " has an invalid zero orientation quaternion";
+	      }
+	  }
+      });
 
-    if (outofsequence)
+    Sim->particles.reserve(firstID + nodes.size());
+    for (const std::vector<Particle>& particles : chunkParticles)
+      Sim->particles.insert(Sim->particles.end(), particles.begin(), particles.end());
+
+    if (std::find(chunkOutOfSequence.begin(), chunkOutOfSequence.end(), true) != chunkOutOfSequence.end())
       dout << "Particle ID's out of sequence!\n"
 	   << "This can result in incorrect capture map loads etc.\n"
 	   << "Erase any capture maps in the configuration file so they are regenerated." << std::endl;
 
     dout << "Particle count " << Sim->N() << std::endl;
-
-    if (XML.getNode("ParticleData").hasAttribute("OrientationData"))
-      {
-	orientationData.resize(Sim->N());
-	size_t i(0);
-	for (magnet::xml::Node node = XML.getNode("ParticleData").findNode("Pt"); node.valid(); ++node, ++i)
-	  {
-	    orientationData[i].orientation << node.getNode("U");
-	    orientationData[i].angularVelocity << node.getNode("O");
-      
-	    //Makes the vector a unit vector
-	    orientationData[i].orientation.normalise();
-	    if (orientationData[i].orientation.nrm() == 0)
-	      M_throw() << "Particle " << i << " has an invalid zero orientation quaternion";
-	  }
-      }
   }
 
   void 
@@ -155,29 +206,42 @@ namespace dynamo {
     if (hasOrientationData())
       XML << magnet::xml::attr("OrientationData") << "Y";
 
-    for (size_t i = 0; i < Sim->N(); ++i)
-      {
-	Particle tmp(Sim->particles[i]);
-	if (applyBC) 
-	  Sim->BCs->applyBC(tmp.getPosition(), tmp.getVelocity());
+    //The particles are formatted in parallel chunks, which are
+    //then appended in order.
+    const size_t chunks = (Sim->N() + particleChunkSize - 1) / particleChunkSize;
+    std::vector<magnet::xml::XmlStream> fragments(chunks);
+    for (magnet::xml::XmlStream& fragment : fragments)
+      fragment.beginFragment(XML);
+
+    forEachParticleChunk(Sim->N(), [&](const size_t chunk, const size_t begin, const size_t end) {
+	magnet::xml::XmlStream& fragment = fragments[chunk];
+	for (size_t i = begin; i < end; ++i)
+	  {
+	    Particle tmp(Sim->particles[i]);
+	    if (applyBC) 
+	      Sim->BCs->applyBC(tmp.getPosition(), tmp.getVelocity());
       
-	tmp.getVelocity() *= (1.0 / Sim->units.unitVelocity());
-	tmp.getPosition() *= (1.0 / Sim->units.unitLength());
+	    tmp.getVelocity() *= (1.0 / Sim->units.unitVelocity());
+	    tmp.getPosition() *= (1.0 / Sim->units.unitLength());
       
-	XML << magnet::xml::tag("Pt");
-	Sim->_properties.outputParticleXMLData(XML, i);
-	XML << tmp;
-
-	if (hasOrientationData())
-	  XML << magnet::xml::tag("O")
-	      << orientationData[i].angularVelocity
-	      << magnet::xml::endtag("O")
-	      << magnet::xml::tag("U")
-	      << orientationData[i].orientation
-	      << magnet::xml::endtag("U") ;
-
-	XML << magnet::xml::endtag("Pt");
-      }
+	    fragment << magnet::xml::tag("Pt");
+	    Sim->_properties.outputParticleXMLData(fragment, i);
+	    fragment << tmp;
+
+	    if (hasOrientationData())
+	      fragment << magnet::xml::tag("O")
+		       << orientationData[i].angularVelocity
+		       << magnet::xml::endtag("O")
+		       << magnet::xml::tag("U")
+		       << orientationData[i].orientation
+		       << magnet::xml::endtag("U") ;
+
+	    fragment << magnet::xml::endtag("Pt");
+	  }
+      });
+
+    for (const magnet::xml::XmlStream& fragment : fragments)
+      XML.appendFragment(fragment);
   
     XML << magnet::xml::endtag("ParticleData");
   }
@@ -195,8 +259,8 @@ namespace dynamo {
   {
     double sumEnergy(0);
 
-    for (const Particle& part : Sim->particles)
-      sumEnergy += Sim->species(part)->getParticleKineticEnergy(part);
+    for (const shared_ptr<Species>& species : Sim->species)
+      sumEnergy += species->getKineticEnergy();
 
     return sumEnergy;
   }
@@ -206,31 +270,32 @@ namespace dynamo {
   {
     double scalefactor(sqrt(scale));
 
+    //The particles are looped over by species, which avoids looking
+    //up the species of every particle.
     if (std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
       {
 	const BCLeesEdwards& bc = static_cast<const BCLeesEdwards&>(*Sim->BCs);
-	for (Particle& part : Sim->particles)
-	  {
-	    const double mass = Sim->species(part)->getMass(part.getID());
-	    if (!std::isinf(mass))
-	      part.getVelocity() = Vector(bc.getPeculiarVelocity(part) * scalefactor + bc.getStreamVelocity(part));
-	  }
+	for (const shared_ptr<Species>& species : Sim->species)
+	  species->forEachParticle(Sim->particles, [&](Particle& part, const double mass) {
+	      if (!std::isinf(mass))
+		part.getVelocity() = Vector(bc.getPeculiarVelocity(part) * scalefactor + bc.getStreamVelocity(part));
+	    });
       }
     else
-      for (Particle& part : Sim->particles)
-	{
-	  const double mass = Sim->species(part)->getMass(part.getID());
-	  if (!std::isinf(mass))
-	    part.getVelocity() *= scalefactor;
-	}
+      for (const shared_ptr<Species>& species : Sim->species)
+	species->forEachParticle(Sim->particles, [scalefactor](Particle& part, const double mass) {
+	    if (!std::isinf(mass))
+	      part.getVelocity() *= scalefactor;
+	  });
 
     if (hasOrientationData())
-      for (Particle& part : Sim->particles)
-	{
-	  const double I = Sim->species(part)->getScalarMomentOfInertia(part.getID());
-	  if (!std::isinf(I))
-	    orientationData[part.getID()].angularVelocity *= scalefactor;
-	}
+      for (const shared_ptr<Species>& species : Sim->species)
+	for (const unsigned long ID : *species->getRange())
+	  {
+	    const double I = species->getScalarMomentOfInertia(ID);
+	    if (!std::isinf(I))
+	      orientationData[ID].angularVelocity *= scalefactor;
+	  }
   }
 
   PairEventData 
@@ -345,12 +410,21 @@ namespace dynamo {
     Vector pos0 = Sim->particles[*(particles.begin())].getPosition(), 
       vel0 = Sim->particles[*(particles.begin())].getVelocity();
 
+    //If the range contains particles of infinite mass, they dominate
+    //the centre of mass. The finite masses are then ignored and the
+    //infinite masses are given an equal weight.
+    bool infiniteMass = false;
+    for (size_t ID : particles)
+      infiniteMass |= std::isinf(Sim->species(Sim->particles[ID])->getMass(ID));
+
     double totMass = 0;
 
     for (size_t ID : particles)
       {
 	const Particle& part = Sim->particles[ID];
 	double mass = Sim->species(part)->getMass(ID);
+	if (infiniteMass)
+	  mass = std::isinf(mass) ? 1.0 : 0.0;
 
 	//Take everything relative to the first particle's position to
 	//minimise issues with PBC wrapping the particles.
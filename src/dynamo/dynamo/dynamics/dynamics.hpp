@@ -62,6 +62,23 @@ namespace dynamo {
       Vector angularVelocity;
     };
 
+    /*! \brief A candidate pair for an ESMC (Enskog DSMC) collision.
+      
+      These are generated and tested in blocks (see
+      DSMCSpheresProbabilities).
+     */
+    struct DSMCCandidate
+    {
+      size_t p1;
+      size_t p2;
+      //! \brief The vector separating the two particles.
+      Vector rij;
+      //! \brief The relative velocity of the two particles.
+      Vector vij;
+      //! \brief The probability of the collision.
+      double prob;
+    };
+
     Dynamics(dynamo::Simulation* tmp):
       SimBase(tmp, "Dynamics"),
       partPecTime(0.0),
@@ -521,6 +538,24 @@ namespace dynamo {
     virtual bool DSMCSpheresTest(Particle& p1, Particle& p2,
 				 double& maxprob, const double& factor,
 				 Vector rij) const = 0;
+
+    /*! \brief Calculates the ESMC collision probabilities of a block
+      of candidate pairs.
+      
+      This is the batched form of \ref DSMCSpheresTest. The
+      particles of each candidate are brought up to date and their
+      relative velocities are gathered into the candidates, before
+      the probabilities are calculated in a single loop. Receding
+      pairs are given a probability of zero. The maximum probability
+      and the acceptance test are left to the caller.
+
+      \param begin The first candidate to test.
+      \param end One past the last candidate to test.
+      \param factor The collision probability factor.
+     */
+    virtual void DSMCSpheresProbabilities(std::vector<DSMCCandidate>::iterator begin,
+					  std::vector<DSMCCandidate>::iterator end,
+					  const double& factor) const = 0;
   
     /*! \brief Performs a hard sphere collision between the two
       particles according to the ESMC (Enskog DSMC)
@@ -660,7 +695,8 @@ namespace dynamo {
        
        Provided the particles are never spread over a distance larger
        than 0.5 box lengths in periodic boundary conditions this
-       function should work.
+       function should work. If any of the particles have an infinite
+       mass, the centre of mass is that of these particles alone.
      */
     std::pair<Vector, Vector> getCOMPosVel(const IDRange& particles) const;
 
@@ -119,10 +119,12 @@ namespace dynamo {
     double mass = Sim->species[tmpDat.getSpeciesID()]->getMass(part.getID());
     double factor = sqrtT / std::sqrt(mass);
 
-    std::normal_distribution<> norm_dist;
+    double normals[NDIM];
+    Sim->getRandomStream(part.getID(), Sim->eventCount).normal(normals, dimensions);
+
     //Assign the new velocities
     for (size_t iDim = 0; iDim < dimensions; iDim++)
-      part.getVelocity()[iDim] = norm_dist(Sim->ranGenerator) * factor;
+      part.getVelocity()[iDim] = normals[iDim] * factor;
 
     return tmpDat;
   }
@@ -246,16 +248,17 @@ namespace dynamo {
  
     double mass = Sim->species[tmpDat.getSpeciesID()]->getMass(part.getID());
 
+    magnet::math::Philox rng = Sim->getRandomStream(part.getID(), Sim->eventCount);
     if (slip != 1) {
-      std::normal_distribution<> norm_dist;
+      double normals[NDIM];
+      rng.normal(normals, NDIM);
       for (size_t iDim = 0; iDim < NDIM; iDim++)
-	part.getVelocity()[iDim] = (1-slip) * norm_dist(Sim->ranGenerator) * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
+	part.getVelocity()[iDim] = (1-slip) * normals[iDim] * sqrtT / std::sqrt(mass) + slip * part.getVelocity()[iDim];
     }
   
-    std::uniform_real_distribution<> uniform_dist;
     part.getVelocity() 
       //This first line adds a component in the direction of the normal
-      += vNorm * (sqrtT * sqrt(-2.0*log(1.0-uniform_dist(Sim->ranGenerator)) / mass)
+      += vNorm * (sqrtT * sqrt(-2.0*log(rng.uniform()) / mass)
 		  //This removes the original normal component
 		  -(part.getVelocity() | vNorm));
 
@@ -343,8 +346,27 @@ namespace dynamo {
     if (prob > maxprob)
       maxprob = prob;
 
-    std::uniform_real_distribution<> uniform_dist;
-    return prob > uniform_dist(Sim->ranGenerator) * maxprob;
+    const size_t pairStream = Sim->N() + Sim->systems.size() + p1.getID() * Sim->N() + p2.getID();
+    return prob > Sim->getRandomStream(pairStream, Sim->eventCount).uniform() * maxprob;
+  }
+
+  void
+  DynNewtonian::DSMCSpheresProbabilities(std::vector<DSMCCandidate>::iterator begin,
+					 std::vector<DSMCCandidate>::iterator end,
+					 const double& factor) const
+  {
+    for (std::vector<DSMCCandidate>::iterator it = begin; it != end; ++it)
+      {
+	Particle& p1 = Sim->particles[it->p1];
+	Particle& p2 = Sim->particles[it->p2];
+	updateParticlePair(p1, p2);
+	it->vij = p1.getVelocity() - p2.getVelocity();
+	Sim->BCs->applyBC(it->rij, it->vij);
+      }
+
+    //The candidates are independent, so this loop may be vectorised
+    for (std::vector<DSMCCandidate>::iterator it = begin; it != end; ++it)
+      it->prob = std::max(-factor * (it->rij | it->vij), 0.0);
   }
 
   PairEventData
@@ -547,54 +569,33 @@ namespace dynamo {
   NEventData 
   DynNewtonian::multibdyWellEvent(const IDRange& range1, const IDRange& range2, const double&, const double& deltaKE, EEventType& eType) const
   {
-    Vector  COMVel1, COMVel2, COMPos1, COMPos2;
-  
     double structmass1(0), structmass2(0);
   
     for (const size_t& ID : range1)
       {
 	updateParticle(Sim->particles[ID]);
-	double mass = Sim->species(Sim->particles[ID])->getMass(ID);
-
-	structmass1 += mass;
-
-	Vector pos(Sim->particles[ID].getPosition()),
-	  vel(Sim->particles[ID].getVelocity());
-      
-	Sim->BCs->applyBC(pos, vel);
-
-	COMVel1 += vel * mass;
-
-	COMPos1 += pos * mass;
+	structmass1 += Sim->species(Sim->particles[ID])->getMass(ID);
       }
   
     for (const size_t& ID : range2)
       {
 	updateParticle(Sim->particles[ID]);
+	structmass2 += Sim->species(Sim->particles[ID])->getMass(ID);
+      }
 
-	double mass = Sim->species(Sim->particles[ID])->getMass(ID);
-      
-	structmass2 += mass;
-      
-	Vector pos(Sim->particles[ID].getPosition()),
-	  vel(Sim->particles[ID].getVelocity());
+    if (std::isinf(structmass1) && std::isinf(structmass2))
+      M_throw() << "Cannot perform a well event between two ranges which both contain infinite masses";
 
-	Sim->BCs->applyBC(pos, vel);
-	COMVel2 += vel * mass;
-	COMPos2 += pos * mass;
-      }
-  
-    COMVel1 /= structmass1;
-    COMVel2 /= structmass2;
-  
-    COMPos1 /= structmass1;
-    COMPos2 /= structmass2;
-  
-    Vector  rij = COMPos1 - COMPos2, vij = COMVel1 - COMVel2;
+    //The centres of mass are calculated as for the event detection,
+    //which also handles any infinite masses in the ranges.
+    const std::pair<Vector, Vector> COM1 = getCOMPosVel(range1);
+    const std::pair<Vector, Vector> COM2 = getCOMPosVel(range2);
+
+    Vector  rij = COM1.first - COM2.first, vij = COM1.second - COM2.second;
     Sim->BCs->applyBC(rij, vij);
     double rvdot = (rij | vij);
 
-    double mu = structmass1 * structmass2 / (structmass1 + structmass2);
+    double mu = 1.0 / ((1.0 / structmass1) + (1.0 / structmass2));
 
     double R2 = rij.nrm2();
     double sqrtArg = rvdot * rvdot + 2.0 * R2 * deltaKE / mu;
@@ -49,6 +49,7 @@ namespace dynamo {
     virtual double getPBCSentinelTime(const Particle&, const double&) const;
     virtual PairEventData SmoothSpheresColl(Event&, const double&, const double&, const EEventType& eType) const;
     virtual bool DSMCSpheresTest(Particle&, Particle&, double&, const double&, Vector) const;
+    virtual void DSMCSpheresProbabilities(std::vector<DSMCCandidate>::iterator, std::vector<DSMCCandidate>::iterator, const double&) const;
     virtual PairEventData DSMCSpheresRun(Particle&, Particle&, const double&, Vector) const;
     virtual PairEventData SphereWellEvent(Event&, const double&, const double&, size_t) const;
     virtual double getPlaneEvent(const Particle&, const Vector &, const Vector &, double) const;
@@ -55,6 +55,7 @@ namespace dynamo {
     virtual std::pair<bool,double> getPointPlateCollision(const Particle& np1, const Vector& nrw0, const Vector& nhat, const double& Delta, const double& Omega, const double& Sigma, const double& t, bool) const { M_throw() << "Not implemented"; }
     virtual ParticleEventData runOscilatingPlate(Particle& part, const Vector& rw0, const Vector& nhat, double& delta, const double& omega0, const double& sigma, const double& mass, const double& e, double& t, bool strongPlate) const { M_throw() << "Not implemented"; }
     virtual bool DSMCSpheresTest(Particle&, Particle&, double&, const double&, Vector) const { M_throw() << "Not implemented"; }
+    virtual void DSMCSpheresProbabilities(std::vector<DSMCCandidate>::iterator, std::vector<DSMCCandidate>::iterator, const double&) const { M_throw() << "Not implemented"; }
     virtual PairEventData DSMCSpheresRun(Particle&, Particle&, const double&, Vector) const { M_throw() << "Not implemented"; }
     virtual PairEventData SphereWellEvent(Event&, const double&, const double&, size_t) const { M_throw() << "Not implemented"; }
     virtual double getPlaneEvent(const Particle&, const Vector &, const Vector &, double) const { M_throw() << "Not implemented"; }
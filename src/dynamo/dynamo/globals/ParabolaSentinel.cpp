@@ -72,8 +72,7 @@ namespace dynamo {
   
     Sim->_sigParticleUpdate(EDat);
 
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->ptrScheduler->outputEventUpdate(iEvent, EDat);
 
     Sim->ptrScheduler->fullUpdate(part);
   }
@@ -0,0 +1,381 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/globals/cellsHierarchical.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/dynamics/compression.hpp>
+#include <dynamo/units/units.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/interactions/interaction.hpp>
+#include <dynamo/BC/LEBC.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace dynamo {
+  GCellsHierarchical::GCellsHierarchical(dynamo::Simulation* nSim, const std::string& name, const double levelRatio):
+    GNeighbourList(nSim, "HierarchicalCellNeighbourList"),
+    overlink(1),
+    _levelRatio(levelRatio)
+  {
+    globName = name;
+    dout << "Hierarchical Cells Loaded" << std::endl;
+  }
+
+  GCellsHierarchical::GCellsHierarchical(const magnet::xml::Node& XML, dynamo::Simulation* ptrSim):
+    GNeighbourList(ptrSim, "HierarchicalCellNeighbourList"),
+    overlink(1),
+    _levelRatio(2)
+  {
+    operator<<(XML);
+
+    dout << "Hierarchical Cells Loaded" << std::endl;
+  }
+
+  void
+  GCellsHierarchical::operator<<(const magnet::xml::Node& XML)
+  {
+    if (XML.hasAttribute("OverLink"))
+      overlink = XML.getAttribute("OverLink").as<size_t>();
+
+    if (XML.hasAttribute("NeighbourhoodRange"))
+      _maxInteractionRange = XML.getAttribute("NeighbourhoodRange").as<double>() * Sim->units.unitLength();
+
+    if (XML.hasAttribute("LevelRatio"))
+      _levelRatio = XML.getAttribute("LevelRatio").as<double>();
+
+    if (_levelRatio <= 1)
+      M_throw() << "The LevelRatio of the HierarchicalCells must be greater than 1";
+
+    globName = XML.getAttribute("Name");
+
+    range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"), Sim));
+  }
+
+  void
+  GCellsHierarchical::outputXML(magnet::xml::XmlStream& XML) const
+  {
+    XML << magnet::xml::tag("Global")
+	<< magnet::xml::attr("Type") << "HierarchicalCells"
+	<< magnet::xml::attr("Name") << globName
+	<< magnet::xml::attr("NeighbourhoodRange")
+	<< _maxInteractionRange / Sim->units.unitLength()
+	<< magnet::xml::attr("LevelRatio") << _levelRatio;
+
+    if (overlink > 1)   XML << magnet::xml::attr("OverLink") << overlink;
+
+    XML << range
+	<< magnet::xml::endtag("Global");
+  }
+
+  Event
+  GCellsHierarchical::getEvent(const Particle& part) const
+  {
+#ifdef ISSS_DEBUG
+    if (!Sim->dynamics->isUpToDate(part))
+      M_throw() << "Particle is not up to date";
+#endif
+    const Level& level = _levels[_particleLevel[part.getID()]];
+    const size_t cellIndex = level.cellData.getCellID(part.getID());
+    return Event(part, Sim->dynamics->getSquareCellCollision2(part, calcPosition(level, level.ordering.toCoord(cellIndex), part), level.cellDimension) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID);
+  }
+
+  void
+  GCellsHierarchical::runEvent(Particle& part, const double)
+  {
+    //See GCells::runEvent for the details of the cell transition
+    Sim->dynamics->updateParticle(part);
+    Sim->ptrScheduler->popNextEvent();
+
+    const size_t L = _particleLevel[part.getID()];
+    Level& level = _levels[L];
+
+    const size_t oldCellIndex = level.cellData.getCellID(part.getID());
+    const auto oldCellCoord = level.ordering.toCoord(oldCellIndex);
+
+    const int cellDirectionInt(Sim->dynamics->getSquareCellCollision3(part, calcPosition(level, oldCellCoord, part), level.cellDimension));
+    const size_t cellDirection = abs(cellDirectionInt) - 1;
+    const size_t dimension = level.ordering.getDimensions()[cellDirection];
+
+    auto newCellCoord = oldCellCoord;
+    newCellCoord[cellDirection] += dimension + ((cellDirectionInt > 0) ? 1 : -1);
+    newCellCoord[cellDirection] %= dimension;
+    const size_t newCellIndex = level.ordering.toIndex(newCellCoord);
+
+    level.cellData.moveTo(oldCellIndex, newCellIndex, part.getID());
+
+    //Particles of the same level which are new neighbours lie in the
+    //slab of cells at the leading edge of the neighbourhood
+    auto newCenterNBCellCoord = newCellCoord;
+    newCenterNBCellCoord[cellDirection] += dimension + ((cellDirectionInt > 0) ? 1 : -1);
+    newCenterNBCellCoord[cellDirection] %= dimension;
+    std::array<size_t, 3> steps{{overlink, overlink, overlink}};
+    steps[cellDirection] = 0;
+
+    for (auto cellIndex : level.ordering.getSurroundingIndices(newCenterNBCellCoord, steps))
+      for (const size_t& next : level.cellData.getCellContents(cellIndex))
+	_sigNewNeighbour(part, next);
+
+    //Particles of the other levels are all rechecked
+    std::vector<size_t> neighbours;
+    getCrossLevelNeighbours(L, newCellIndex, part, neighbours);
+    for (const size_t& next : neighbours)
+      _sigNewNeighbour(part, next);
+
+    Sim->ptrScheduler->pushEvent(getEvent(part));
+    _sigCellChange(part, oldCellIndex);
+  }
+
+  void
+  GCellsHierarchical::initialise(size_t nID)
+  {
+    Global::initialise(nID);
+
+    if (std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
+      M_throw() << "HierarchicalCells do not support Lees-Edwards boundary conditions";
+
+    if (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics))
+      M_throw() << "HierarchicalCells do not support compression dynamics";
+
+    reinitialise();
+  }
+
+  void
+  GCellsHierarchical::reinitialise()
+  {
+    GNeighbourList::reinitialise();
+
+    dout << "Reinitialising on collision " << Sim->eventCount << std::endl;
+
+    //Determine the interaction range of each particle. Only the
+    //interactions which can involve the particle are considered, as
+    //the default particleMaxIntDist() is the range of the whole
+    //interaction.
+    std::vector<std::pair<double, size_t> > ranges;
+    for (const size_t& pid : *range)
+      {
+	double r = 0;
+	for (const shared_ptr<Interaction>& interaction : Sim->interactions)
+	  if (interaction->getRange()->isInRange(Sim->particles[pid]))
+	    r = std::max(r, interaction->particleMaxIntDist(pid));
+	ranges.push_back(std::make_pair(r, pid));
+      }
+    std::sort(ranges.begin(), ranges.end(), std::greater<std::pair<double, size_t> >());
+
+    //Group the particles into levels, starting with the largest
+    //ranges.
+    std::vector<double> levelRanges(1, _maxInteractionRange);
+    std::vector<std::vector<size_t> > levelIDs(1);
+    _particleLevel.assign(Sim->N(), std::numeric_limits<size_t>::max());
+    for (const auto& entry : ranges)
+      {
+	if ((entry.first > 0) && (entry.first * _levelRatio < levelRanges.back()))
+	  {
+	    levelRanges.push_back(entry.first);
+	    levelIDs.push_back(std::vector<size_t>());
+	  }
+
+	_particleLevel[entry.second] = levelRanges.size() - 1;
+	levelIDs.back().push_back(entry.second);
+      }
+
+    _levels.clear();
+    _levels.resize(levelRanges.size());
+    for (size_t L(0); L < _levels.size(); ++L)
+      {
+	_levels[L].range = levelRanges[L];
+	dout << "Level " << L << ", Interaction range " << levelRanges[L] / Sim->units.unitLength()
+	     << ", Particles " << levelIDs[L].size() << std::endl;
+	buildLevel(_levels[L], levelIDs[L]);
+      }
+
+    _sigReInitialise();
+  }
+
+  void
+  GCellsHierarchical::buildLevel(Level& level, const std::vector<size_t>& IDs)
+  {
+    //Size the cells as for GCells, but using the range and particle
+    //count of this level
+    const double minDistance = level.range / overlink;
+    const double unityOccupancy = std::cbrt(Sim->getSimVolume() / std::max(IDs.size(), size_t(1)));
+    const double l = std::max(minDistance, unityOccupancy);
+
+    std::array<size_t, 3> cellCount;
+    const double embiggen = 1.0 + 10 * std::numeric_limits<double>::epsilon();
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	cellCount[iDim] = int(Sim->primaryCellSize[iDim] / (l * embiggen));
+	cellCount[iDim] = std::max(cellCount[iDim], size_t(4));
+	cellCount[iDim] = std::max(cellCount[iDim], size_t(2) * overlink + size_t(1));
+      }
+
+    const double overlap = 0.9;
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	level.cellLatticeWidth[iDim] = Sim->primaryCellSize[iDim] / cellCount[iDim];
+	level.cellDimension[iDim] = level.cellLatticeWidth[iDim] + (level.cellLatticeWidth[iDim] - level.range) * overlap;
+	level.cellOffset[iDim] = -(level.cellLatticeWidth[iDim] - level.range) * overlap * 0.5;
+      }
+    level.ordering = Ordering(cellCount);
+
+    dout << "Cells " << cellCount[0] << "," << cellCount[1] << "," << cellCount[2]
+	 << "\nLattice spacing "
+	 << level.cellLatticeWidth[0] / Sim->units.unitLength() << ","
+	 << level.cellLatticeWidth[1] / Sim->units.unitLength() << ","
+	 << level.cellLatticeWidth[2] / Sim->units.unitLength()
+	 << "\nSupported Interaction range " << getMaxSupportedInteractionLength(level) / Sim->units.unitLength()
+	 << std::endl;
+
+    if (getMaxSupportedInteractionLength(level) < level.range)
+      M_throw() << "The system size is too small to support the range of interactions specified (i.e. the system is smaller than the interaction diameter of one particle).";
+
+    level.cellData.clear();
+    level.cellData.resize(level.ordering.length(), Sim->particles.size());
+
+    //Required so particles find the right owning cell
+    Sim->dynamics->updateAllParticles();
+    for (const size_t& pid : IDs)
+      level.cellData.add(level.ordering.toIndex(getCellCoords(level, Sim->particles[pid].getPosition())), pid);
+  }
+
+  double
+  GCellsHierarchical::getMaxSupportedInteractionLength() const
+  {
+    if (_levels.empty()) return 0;
+    return getMaxSupportedInteractionLength(_levels.front());
+  }
+
+  double
+  GCellsHierarchical::getMaxSupportedInteractionLength(const Level& level) const
+  {
+    double retval(std::numeric_limits<float>::infinity());
+    for (size_t i = 0; i < NDIM; ++i)
+      {
+	double supported_length = (1 + overlink) * level.cellLatticeWidth[i] - level.cellDimension[i];
+	if (level.ordering.getDimensions()[i] == 2 * overlink + 1)
+	  supported_length = Sim->primaryCellSize[i];
+	retval = std::min(retval, supported_length);
+      }
+    return retval;
+  }
+
+  std::array<size_t, 3>
+  GCellsHierarchical::getCellCoords(const Level& level, Vector pos) const
+  {
+    Sim->BCs->applyBC(pos);
+
+    std::array<size_t, 3> retval;
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	long coord = std::floor((pos[iDim] - level.cellOffset[iDim]) / level.cellLatticeWidth[iDim] + 0.5 * level.ordering.getDimensions()[iDim]);
+	coord %= long(level.ordering.getDimensions()[iDim]);
+	if (coord < 0) coord += level.ordering.getDimensions()[iDim];
+	retval[iDim] = coord;
+      }
+
+    return retval;
+  }
+
+  Vector
+  GCellsHierarchical::calcPosition(const Level& level, const std::array<size_t, 3>& coords, const Particle& part) const
+  {
+    //We always return the cell that is periodically nearest to the particle
+    Vector primaryCell = calcPosition(level, coords);
+    Vector imageCell;
+
+    for (size_t i = 0; i < NDIM; ++i)
+      imageCell[i] = primaryCell[i] - Sim->primaryCellSize[i] * lrint((primaryCell[i] - part.getPosition()[i]) / Sim->primaryCellSize[i]);
+
+    return imageCell;
+  }
+
+  Vector
+  GCellsHierarchical::calcPosition(const Level& level, const std::array<size_t, 3>& coords) const
+  {
+    Vector primaryCell;
+    for (size_t i(0); i < NDIM; ++i)
+      primaryCell[i] = coords[i] * level.cellLatticeWidth[i] - 0.5 * Sim->primaryCellSize[i] + level.cellOffset[i];
+    return primaryCell;
+  }
+
+  void
+  GCellsHierarchical::getBoxNeighbours(const Level& level, const Vector& lower, const Vector& upper, const double R, std::vector<size_t>& retlist) const
+  {
+    //A cell with coordinate k spans [origin_k, origin_k + cellDimension],
+    //where origin_k = k * cellLatticeWidth - 0.5 * primaryCellSize + cellOffset
+    std::array<std::vector<size_t>, 3> coords;
+    for (size_t iDim = 0; iDim < NDIM; ++iDim)
+      {
+	const long n = level.ordering.getDimensions()[iDim];
+	const double shift = 0.5 * Sim->primaryCellSize[iDim] - level.cellOffset[iDim];
+	const long kmin = std::floor((lower[iDim] - R - level.cellDimension[iDim] + shift) / level.cellLatticeWidth[iDim]);
+	const long kmax = std::floor((upper[iDim] + R + shift) / level.cellLatticeWidth[iDim]);
+
+	if (kmax - kmin + 1 >= n)
+	  for (long k(0); k < n; ++k)
+	    coords[iDim].push_back(k);
+	else
+	  for (long k(kmin); k <= kmax; ++k)
+	    coords[iDim].push_back(((k % n) + n) % n);
+      }
+
+    for (const size_t& x : coords[0])
+      for (const size_t& y : coords[1])
+	for (const size_t& z : coords[2])
+	  {
+	    const auto& neighbours = level.cellData.getCellContents(level.ordering.toIndex(std::array<size_t, 3>{{x, y, z}}));
+	    retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+	  }
+  }
+
+  void
+  GCellsHierarchical::getCrossLevelNeighbours(const size_t L, const size_t cellIndex, const Particle& part, std::vector<size_t>& retlist) const
+  {
+    const Level& level = _levels[L];
+    const Vector lower = calcPosition(level, level.ordering.toCoord(cellIndex), part);
+    const Vector upper = lower + level.cellDimension;
+
+    for (size_t M(0); M < _levels.size(); ++M)
+      if (M != L)
+	getBoxNeighbours(_levels[M], lower, upper, std::max(level.range, _levels[M].range), retlist);
+  }
+
+  void
+  GCellsHierarchical::getParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+  {
+    const size_t L = _particleLevel[part.getID()];
+    const Level& level = _levels[L];
+    const size_t cellIndex = level.cellData.getCellID(part.getID());
+
+    for (auto nbIndex : level.ordering.getSurroundingIndices(level.ordering.toCoord(cellIndex), std::array<size_t, 3>{{overlink, overlink, overlink}}))
+      {
+	const auto& neighbours = level.cellData.getCellContents(nbIndex);
+	retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+      }
+
+    getCrossLevelNeighbours(L, cellIndex, part, retlist);
+  }
+
+  void
+  GCellsHierarchical::getParticleNeighbours(const Vector& vec, std::vector<size_t>& retlist) const
+  {
+    for (const Level& level : _levels)
+      getBoxNeighbours(level, vec, vec, _levels.front().range, retlist);
+  }
+}
@@ -0,0 +1,126 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/globals/cells.hpp>
+
+namespace dynamo {
+  /*! \brief A multi-level cell neighbour list for systems with
+    widely differing interaction ranges (e.g., colloid/solvent
+    mixtures).
+
+    The \ref GCells neighbour list sizes its cells using the longest
+    interaction in the system. A few large particles therefore force
+    huge cells onto all of the small particles. Here, each particle
+    is instead placed in one of several regular grids ("levels"),
+    whose cells are sized for the interaction range of the particles
+    they contain. The interaction range of a particle is given by
+    Interaction::particleMaxIntDist().
+
+    Each level works exactly like a \ref GCells neighbour list for
+    the pairs within it. Pairs between two levels are found by
+    scanning the cells of the other level which lie within the
+    longer of the two level ranges of the particle's current cell. As
+    either particle must enter a new cell before such a pair can
+    come into range, the particle entering the new cell always finds
+    the other.
+
+    Particles are grouped into the same level if their interaction
+    ranges are within a factor of "LevelRatio" (default 2) of each
+    other.
+   */
+  class GCellsHierarchical: public GNeighbourList
+  {
+  public:
+    GCellsHierarchical(const magnet::xml::Node&, dynamo::Simulation*);
+    GCellsHierarchical(Simulation*, const std::string&, const double levelRatio = 2);
+
+    virtual ~GCellsHierarchical() {}
+
+    virtual Event getEvent(const Particle &) const;
+
+    virtual void runEvent(Particle&, const double);
+
+    virtual void initialise(size_t);
+
+    virtual void reinitialise();
+
+    void getParticleNeighbours(const Particle&, std::vector<size_t>&) const;
+    void getParticleNeighbours(const Vector&, std::vector<size_t>&) const;
+
+    virtual void operator<<(const magnet::xml::Node&);
+
+    /*! \brief The interaction length supported by the coarsest
+        level.
+
+	Finer levels support shorter interactions, but only contain
+	particles with shorter interaction ranges.
+     */
+    virtual double getMaxSupportedInteractionLength() const;
+
+    /*! \brief The number of levels currently in use. */
+    size_t getLevelCount() const { return _levels.size(); }
+
+  protected:
+    typedef magnet::containers::RowMajorOrdering<3> Ordering;
+
+    struct Level
+    {
+      double range;
+      Ordering ordering;
+      Vector cellDimension;
+      Vector cellLatticeWidth;
+      Vector cellOffset;
+#ifdef DYNAMO_JUDY
+      detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			       magnet::containers::JudyMap<size_t, size_t>> cellData;
+#else
+      detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			       std::unordered_map<size_t, size_t> > cellData;
+#endif
+    };
+
+    //! \brief The levels, ordered from the coarsest to the finest.
+    std::vector<Level> _levels;
+    //! \brief The level of each particle.
+    std::vector<size_t> _particleLevel;
+
+    size_t overlink;
+    double _levelRatio;
+
+    virtual void outputXML(magnet::xml::XmlStream&) const;
+
+    void buildLevel(Level&, const std::vector<size_t>& IDs);
+
+    double getMaxSupportedInteractionLength(const Level&) const;
+
+    std::array<size_t, 3> getCellCoords(const Level&, Vector) const;
+
+    Vector calcPosition(const Level&, const std::array<size_t, 3>& coords, const Particle& part) const;
+    Vector calcPosition(const Level&, const std::array<size_t, 3>& coords) const;
+
+    /*! \brief Adds the contents of all cells of a level which may
+        lie within a distance R of the box [lower, upper].
+     */
+    void getBoxNeighbours(const Level&, const Vector& lower, const Vector& upper, double R, std::vector<size_t>&) const;
+
+    /*! \brief Adds the particles of all other levels which may
+        interact with a particle in the given cell of level L.
+     */
+    void getCrossLevelNeighbours(size_t L, size_t cellIndex, const Particle&, std::vector<size_t>&) const;
+  };
+}
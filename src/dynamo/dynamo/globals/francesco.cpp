@@ -106,8 +106,7 @@ namespace dynamo {
     part.getVelocity() = _vel * (Sim->dynamics->getRotData(part).orientation * magnet::math::Quaternion::initialDirector());
 
     Sim->_sigParticleUpdate(EDat);
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->ptrScheduler->outputEventUpdate(iEvent, EDat);
     Sim->ptrScheduler->fullUpdate(part);
   }
 }
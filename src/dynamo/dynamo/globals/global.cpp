@@ -53,6 +53,10 @@ namespace dynamo {
 	else
 	  return shared_ptr<Global>(new GCells(XML, Sim));
       }
+    else if (!XML.getAttribute("Type").getValue().compare("NeighbourSpheres"))
+      return shared_ptr<Global>(new GNeighbourSpheres(XML, Sim));
+    else if (!XML.getAttribute("Type").getValue().compare("HierarchicalCells"))
+      return shared_ptr<Global>(new GCellsHierarchical(XML, Sim));
     else if (!XML.getAttribute("Type").getValue().compare("SOCells"))
       return shared_ptr<Global>(new GSOCells(XML, Sim));
     else if (!XML.getAttribute("Type").getValue().compare("Francesco"))
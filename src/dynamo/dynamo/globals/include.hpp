@@ -17,6 +17,8 @@
 
 #include <dynamo/globals/cells.hpp>
 #include <dynamo/globals/cellsShearing.hpp>
+#include <dynamo/globals/cellsHierarchical.hpp>
+#include <dynamo/globals/neighbourSpheres.hpp>
 #include <dynamo/globals/PBCSentinel.hpp>
 #include <dynamo/globals/ParabolaSentinel.hpp>
 #include <dynamo/globals/socells.hpp>
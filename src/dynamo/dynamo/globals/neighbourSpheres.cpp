@@ -0,0 +1,313 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/globals/neighbourSpheres.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/dynamics/compression.hpp>
+#include <dynamo/units/units.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/BC/LEBC.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace dynamo {
+  //! \brief The default skin radius, as a fraction of the interaction range.
+  static const double defaultSkinFraction = 0.3;
+
+  GNeighbourSpheres::GNeighbourSpheres(dynamo::Simulation* nSim, const std::string& name, double skin):
+    GNeighbourList(nSim, "NeighbourSphereList"),
+    _skinSetting(skin),
+    _skin(0)
+  {
+    globName = name;
+    dout << "Neighbour Spheres Loaded" << std::endl;
+  }
+
+  GNeighbourSpheres::GNeighbourSpheres(const magnet::xml::Node& XML, dynamo::Simulation* ptrSim):
+    GNeighbourList(ptrSim, "NeighbourSphereList"),
+    _skinSetting(0),
+    _skin(0)
+  {
+    operator<<(XML);
+
+    dout << "Neighbour Spheres Loaded" << std::endl;
+  }
+
+  void
+  GNeighbourSpheres::operator<<(const magnet::xml::Node& XML)
+  {
+    if (XML.hasAttribute("NeighbourhoodRange"))
+      _maxInteractionRange = XML.getAttribute("NeighbourhoodRange").as<double>() * Sim->units.unitLength();
+
+    if (XML.hasAttribute("Skin"))
+      {
+	_skinSetting = XML.getAttribute("Skin").as<double>() * Sim->units.unitLength();
+	if (_skinSetting <= 0)
+	  M_throw() << "The Skin of the NeighbourSpheres must be positive";
+      }
+
+    globName = XML.getAttribute("Name");
+
+    range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"), Sim));
+  }
+
+  void
+  GNeighbourSpheres::outputXML(magnet::xml::XmlStream& XML) const
+  {
+    XML << magnet::xml::tag("Global")
+	<< magnet::xml::attr("Type") << "NeighbourSpheres"
+	<< magnet::xml::attr("Name") << globName
+	<< magnet::xml::attr("NeighbourhoodRange")
+	<< _maxInteractionRange / Sim->units.unitLength();
+
+    if (_skinSetting) XML << magnet::xml::attr("Skin") << _skinSetting / Sim->units.unitLength();
+
+    XML << range
+	<< magnet::xml::endtag("Global");
+  }
+
+  Event
+  GNeighbourSpheres::getEvent(const Particle& part) const
+  {
+#ifdef ISSS_DEBUG
+    if (!Sim->dynamics->isUpToDate(part))
+      M_throw() << "Particle is not up to date";
+#endif
+    //The sphere centre is treated as a stationary particle which
+    //does not feel any external fields.
+    Particle centre(_centres[part.getID()], Vector{0, 0, 0}, part.getID());
+    centre.clearState(Particle::DYNAMIC);
+
+    return Event(part, Sim->dynamics->SphereSphereOutRoot(part, centre, _skin) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID);
+  }
+
+  void
+  GNeighbourSpheres::runEvent(Particle& part, const double dt)
+  {
+    //Unlike the GCells transitions, this event cannot be run early,
+    //as a sphere recentred on the current position would be left
+    //at the same time again. The system is streamed up to the
+    //event, as for the GPBCSentinel.
+    Event iEvent(part, dt, GLOBAL, VIRTUAL, ID);
+
+    Sim->systemTime += iEvent._dt;
+    Sim->ptrScheduler->stream(iEvent._dt);
+    Sim->stream(iEvent._dt);
+
+    Sim->dynamics->updateParticle(part);
+    Sim->ptrScheduler->popNextEvent();
+
+    const size_t oldCellIndex = _cellData.getCellID(part.getID());
+    rebuildParticle(part);
+
+    //The velocity of the particle is unchanged, so its other events
+    //are still valid and only the next sphere exit is needed.
+    Sim->ptrScheduler->pushEvent(getEvent(part));
+
+    NEventData EDat(ParticleEventData(part, *Sim->species(part), VIRTUAL));
+    Sim->_sigParticleUpdate(EDat);
+    Sim->ptrScheduler->outputEventUpdate(iEvent, EDat);
+    _sigCellChange(part, oldCellIndex);
+  }
+
+  void
+  GNeighbourSpheres::initialise(size_t nID)
+  {
+    Global::initialise(nID);
+
+    if (std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
+      M_throw() << "NeighbourSpheres do not support Lees-Edwards boundary conditions";
+
+    if (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics))
+      M_throw() << "NeighbourSpheres do not support compression dynamics";
+
+    reinitialise();
+  }
+
+  void
+  GNeighbourSpheres::reinitialise()
+  {
+    GNeighbourList::reinitialise();
+
+    dout << "Reinitialising on collision " << Sim->eventCount << std::endl;
+
+    _skin = _skinSetting ? _skinSetting : defaultSkinFraction * _maxInteractionRange;
+    const double listRange = _maxInteractionRange + 2 * _skin;
+
+    //The coarse grid only needs cells wider than the list range. If
+    //there are not enough cells to have distinct neighbouring cells
+    //in a dimension, that dimension is not divided at all.
+    std::array<size_t, 3> cellCount;
+    const double embiggen = 1.0 + 10 * std::numeric_limits<double>::epsilon();
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	cellCount[iDim] = size_t(Sim->primaryCellSize[iDim] / (listRange * embiggen));
+	_cellSteps[iDim] = 1;
+	if (cellCount[iDim] < 3)
+	  {
+	    cellCount[iDim] = 1;
+	    _cellSteps[iDim] = 0;
+	  }
+	_cellWidth[iDim] = Sim->primaryCellSize[iDim] / cellCount[iDim];
+      }
+    _ordering = Ordering(cellCount);
+
+    dout << "Skin " << _skin / Sim->units.unitLength()
+	 << "\nCells " << cellCount[0] << "," << cellCount[1] << "," << cellCount[2]
+	 << std::endl;
+
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      if (listRange > 0.5 * Sim->primaryCellSize[iDim])
+	M_throw() << "The system size is too small to support the range of interactions and skin specified.";
+
+    Sim->dynamics->updateAllParticles();
+
+    _cellData.clear();
+    _cellData.resize(_ordering.length(), Sim->particles.size());
+    _centres.assign(Sim->N(), Vector{0, 0, 0});
+    _neighbours.assign(Sim->N(), std::vector<size_t>());
+
+    for (const size_t& pid : *range)
+      {
+	_centres[pid] = Sim->particles[pid].getPosition();
+	_cellData.add(getCellIndex(_centres[pid]), pid);
+      }
+
+    std::vector<size_t> candidates;
+    for (const size_t& pid : *range)
+      {
+	candidates.clear();
+	getCellNeighbours(_cellData.getCellID(pid), candidates);
+	for (const size_t& id : candidates)
+	  {
+	    if (id == pid) continue;
+	    Vector rij = _centres[pid] - _centres[id];
+	    Sim->BCs->applyBC(rij);
+	    if (rij.nrm2() < listRange * listRange)
+	      _neighbours[pid].push_back(id);
+	  }
+      }
+
+    _sigReInitialise();
+  }
+
+  void
+  GNeighbourSpheres::rebuildParticle(const Particle& part)
+  {
+    const size_t pid = part.getID();
+    const double listRange = _maxInteractionRange + 2 * _skin;
+
+    //Remove the particle from the lists of its old neighbours
+    std::vector<size_t> oldNeighbours;
+    std::swap(oldNeighbours, _neighbours[pid]);
+    for (const size_t& id : oldNeighbours)
+      {
+	std::vector<size_t>& list = _neighbours[id];
+	auto it = std::find(list.begin(), list.end(), pid);
+	*it = list.back();
+	list.pop_back();
+      }
+
+    //Move the sphere
+    _centres[pid] = part.getPosition();
+    const size_t oldCellIndex = _cellData.getCellID(pid);
+    const size_t newCellIndex = getCellIndex(_centres[pid]);
+    if (oldCellIndex != newCellIndex)
+      _cellData.moveTo(oldCellIndex, newCellIndex, pid);
+
+    //Collect the new neighbours
+    std::vector<size_t> candidates;
+    getCellNeighbours(newCellIndex, candidates);
+    std::vector<size_t>& neighbours = _neighbours[pid];
+    for (const size_t& id : candidates)
+      {
+	if (id == pid) continue;
+	Vector rij = _centres[pid] - _centres[id];
+	Sim->BCs->applyBC(rij);
+	if (rij.nrm2() < listRange * listRange)
+	  {
+	    neighbours.push_back(id);
+	    _neighbours[id].push_back(pid);
+	  }
+      }
+
+    //Only particles which were not already neighbours need new events
+    std::sort(oldNeighbours.begin(), oldNeighbours.end());
+    for (const size_t& id : neighbours)
+      if (!std::binary_search(oldNeighbours.begin(), oldNeighbours.end(), id))
+	_sigNewNeighbour(part, id);
+  }
+
+  size_t
+  GNeighbourSpheres::getCellIndex(Vector pos) const
+  {
+    Sim->BCs->applyBC(pos);
+
+    std::array<size_t, 3> coords;
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	long coord = std::floor(pos[iDim] / _cellWidth[iDim] + 0.5 * _ordering.getDimensions()[iDim]);
+	coord %= long(_ordering.getDimensions()[iDim]);
+	if (coord < 0) coord += _ordering.getDimensions()[iDim];
+	coords[iDim] = coord;
+      }
+
+    return _ordering.toIndex(coords);
+  }
+
+  void
+  GNeighbourSpheres::getCellNeighbours(const size_t cellIndex, std::vector<size_t>& retlist) const
+  {
+    for (auto nbIndex : _ordering.getSurroundingIndices(_ordering.toCoord(cellIndex), _cellSteps))
+      {
+	const auto& neighbours = _cellData.getCellContents(nbIndex);
+	retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+      }
+  }
+
+  double
+  GNeighbourSpheres::getMaxSupportedInteractionLength() const
+  { return _maxInteractionRange; }
+
+  void
+  GNeighbourSpheres::getParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+  {
+    const std::vector<size_t>& neighbours = _neighbours[part.getID()];
+    retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+  }
+
+  void
+  GNeighbourSpheres::getParticleNeighbours(const Vector& vec, std::vector<size_t>& retlist) const
+  {
+    //Any particle within the interaction range of the point has its
+    //sphere centre within the interaction range plus the skin.
+    const double R = _maxInteractionRange + _skin;
+    std::vector<size_t> candidates;
+    getCellNeighbours(getCellIndex(vec), candidates);
+    for (const size_t& id : candidates)
+      {
+	Vector rij = vec - _centres[id];
+	Sim->BCs->applyBC(rij);
+	if (rij.nrm2() < R * R)
+	  retlist.push_back(id);
+      }
+  }
+}
@@ -0,0 +1,112 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/globals/cells.hpp>
+
+namespace dynamo {
+  /*! \brief An event-driven neighbour list using bounding ("skin")
+    spheres.
+
+    Each particle is bounded by a sphere of radius "Skin", centred on
+    the position of the particle when its neighbour list was last
+    built. The only events this neighbour list generates are the
+    particles leaving their bounding spheres.
+
+    Two particles may only interact if their sphere centres are closer
+    than the interaction range plus twice the skin. Each particle
+    keeps an explicit list of all such particles, which is only
+    rebuilt (from a coarse grid of the sphere centres) when the
+    particle leaves its sphere. As the sphere centres only move during
+    a rebuild, there are no cell transition events. In dense systems,
+    a particle typically leaves its sphere far less often than it
+    would cross the cells of a \ref GCells neighbour list, and the
+    neighbour lists are also much shorter than the 27 surrounding
+    cells of a \ref GCells neighbour list.
+
+    The "Skin" defaults to 0.3 times the interaction range. Larger
+    skins generate fewer events, but longer neighbour lists.
+   */
+  class GNeighbourSpheres: public GNeighbourList
+  {
+  public:
+    GNeighbourSpheres(const magnet::xml::Node&, dynamo::Simulation*);
+    GNeighbourSpheres(Simulation*, const std::string&, double skin = 0);
+
+    virtual ~GNeighbourSpheres() {}
+
+    virtual Event getEvent(const Particle &) const;
+
+    virtual void runEvent(Particle&, const double);
+
+    virtual void initialise(size_t);
+
+    virtual void reinitialise();
+
+    void getParticleNeighbours(const Particle&, std::vector<size_t>&) const;
+    void getParticleNeighbours(const Vector&, std::vector<size_t>&) const;
+
+    virtual void operator<<(const magnet::xml::Node&);
+
+    virtual double getMaxSupportedInteractionLength() const;
+
+    /*! \brief The radius of the bounding spheres. */
+    double getSkin() const { return _skin; }
+
+  protected:
+    typedef magnet::containers::RowMajorOrdering<3> Ordering;
+
+    virtual void outputXML(magnet::xml::XmlStream&) const;
+
+    /*! \brief Rebuilds the neighbour list of a particle, centring
+        its bounding sphere on its current position.
+
+	The particles which were not previously neighbours are
+	reported through \ref _sigNewNeighbour.
+     */
+    void rebuildParticle(const Particle&);
+
+    size_t getCellIndex(Vector) const;
+
+    /*! \brief Adds all particles whose sphere centres lie in the
+        cells surrounding the given cell.
+     */
+    void getCellNeighbours(size_t cellIndex, std::vector<size_t>&) const;
+
+    //! \brief The skin radius, or zero if it is set automatically.
+    double _skinSetting;
+    double _skin;
+
+    //! \brief The centres of the bounding spheres.
+    std::vector<Vector> _centres;
+    //! \brief The neighbours of each particle.
+    std::vector<std::vector<size_t> > _neighbours;
+
+    //! \brief A coarse grid of the sphere centres.
+    Ordering _ordering;
+    Vector _cellWidth;
+    std::array<size_t, 3> _cellSteps;
+
+#ifdef DYNAMO_JUDY
+    detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			     magnet::containers::JudyMap<size_t, size_t>> _cellData;
+#else
+    detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			     std::unordered_map<size_t, size_t> > _cellData;
+#endif
+  };
+}
@@ -154,8 +154,7 @@ namespace dynamo {
     //Now we're past the event update everything
     Sim->_sigParticleUpdate(EDat);
     Sim->ptrScheduler->fullUpdate(part);
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->ptrScheduler->outputEventUpdate(iEvent, EDat);
 
   }
 
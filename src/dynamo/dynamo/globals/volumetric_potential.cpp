@@ -101,8 +101,7 @@ namespace dynamo {
     //Now we're past the event update the scheduler and plugins
     Sim->_sigParticleUpdate(EDat);
     Sim->ptrScheduler->fullUpdate(part);  
-    for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-      Ptr->eventUpdate(iEvent, EDat);
+    Sim->ptrScheduler->outputEventUpdate(iEvent, EDat);
   }
 
   void 
@@ -20,12 +20,15 @@
 #include <dynamo/particle.hpp>
 #include <dynamo/interactions/interaction.hpp>
 #include <magnet/exception.hpp>
-#ifdef DYNAMO_JUDY
+#if defined(DYNAMO_JUDY)
 # include <magnet/containers/judy.hpp>
-#else
-# include <unordered_map>
 #endif
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace dynamo { 
@@ -93,7 +96,139 @@ namespace dynamo {
       deletes entries when they are set to 0.
     */
 
-#ifdef DYNAMO_JUDY
+    /*! \brief A map of PairKey's to size_t values, stored as a
+      sorted list of (partner, value) entries for each particle.
+
+      Each pair is stored in the list of its lower particle ID. As
+      particles typically have only a handful of captured partners, a
+      lookup is a short linear scan of a contiguous array rather than
+      a hash table probe. Iteration is ordered by the lower particle
+      ID and then by the higher particle ID (this is not the ordering
+      of the PairKey values, which place the higher ID in the most
+      significant bits).
+
+      This container is used for the CaptureMap if
+      DYNAMO_ADJACENCY_CAPTUREMAP is defined.
+
+      Only the subset of the std::map interface required by
+      CaptureMap is provided, and only const iterators are available
+      (like the JudyMap).
+     */
+    class AdjacencyCaptureMap
+    {
+      typedef std::pair<uint32_t, size_t> Entry;
+      typedef std::vector<Entry> Entries;
+
+    public:
+      typedef PairKey key_type;
+      typedef size_t mapped_type;
+      typedef std::pair<key_type, mapped_type> value_type;
+
+      class const_iterator
+      {
+      public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef AdjacencyCaptureMap::value_type value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const value_type* pointer;
+	typedef const value_type& reference;
+
+	const_iterator(const AdjacencyCaptureMap& map, size_t ID, size_t pos):
+	  _map(&map), _ID(ID), _pos(pos), _value(PairKey(uint64_t(0)), 0)
+	{ settle(); }
+
+	const_iterator& operator++() { ++_pos; settle(); return *this; }
+	const_iterator operator++(int) { const_iterator tmp(*this); ++(*this); return tmp; }
+	const value_type& operator*() const { return _value; }
+	const value_type* operator->() const { return &_value; }
+	bool operator==(const const_iterator& o) const { return (_ID == o._ID) && (_pos == o._pos); }
+	bool operator!=(const const_iterator& o) const { return !(*this == o); }
+
+      private:
+	//Skip over exhausted entry lists and update the value
+	void settle()
+	{
+	  while ((_ID < _map->_adjacency.size()) && (_pos >= _map->_adjacency[_ID].size()))
+	    { ++_ID; _pos = 0; }
+
+	  if (_ID < _map->_adjacency.size())
+	    {
+	      const Entry& entry = _map->_adjacency[_ID][_pos];
+	      _value = value_type(PairKey(_ID, entry.first), entry.second);
+	    }
+	  else
+	    _pos = 0;
+	}
+
+	const AdjacencyCaptureMap* _map;
+	size_t _ID;
+	size_t _pos;
+	value_type _value;
+      };
+      typedef const_iterator iterator;
+
+      AdjacencyCaptureMap(): _count(0) {}
+
+      const_iterator begin() const { return const_iterator(*this, 0, 0); }
+      const_iterator end() const { return const_iterator(*this, _adjacency.size(), 0); }
+
+      size_t size() const { return _count; }
+      bool empty() const { return _count == 0; }
+
+      void clear() { _adjacency.clear(); _count = 0; }
+
+      const_iterator find(const key_type& key) const
+      {
+	if (key.first >= _adjacency.size()) return end();
+	const Entries& entries = _adjacency[key.first];
+	//A linear scan, as the lists are short
+	for (size_t i(0); i < entries.size(); ++i)
+	  if (entries[i].first == key.second)
+	    return const_iterator(*this, key.first, i);
+	return end();
+      }
+
+      size_t count(const key_type& key) const { return find(key) != end(); }
+
+      size_t erase(const key_type& key)
+      {
+	if (key.first >= _adjacency.size()) return 0;
+	Entries& entries = _adjacency[key.first];
+	for (auto it = entries.begin(); it != entries.end(); ++it)
+	  if (it->first == key.second)
+	    {
+	      entries.erase(it);
+	      --_count;
+	      return 1;
+	    }
+	return 0;
+      }
+
+      mapped_type& operator[](const key_type& key)
+      {
+	if (key.first >= _adjacency.size())
+	  _adjacency.resize(key.first + 1);
+
+	Entries& entries = _adjacency[key.first];
+	auto it = entries.begin();
+	while ((it != entries.end()) && (it->first < key.second)) ++it;
+
+	if ((it == entries.end()) || (it->first != key.second))
+	  {
+	    it = entries.insert(it, Entry(key.second, 0));
+	    ++_count;
+	  }
+	return it->second;
+      }
+
+    private:
+      std::vector<Entries> _adjacency;
+      size_t _count;
+    };
+
+#if defined(DYNAMO_ADJACENCY_CAPTUREMAP)
+    typedef AdjacencyCaptureMap CaptureMapContainer;
+#elif defined(DYNAMO_JUDY)
     typedef magnet::containers::JudyMap<PairKey, size_t> CaptureMapContainer;
 #else
     typedef std::unordered_map<PairKey, size_t> CaptureMapContainer;
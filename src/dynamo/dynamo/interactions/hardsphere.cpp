@@ -71,6 +71,10 @@ namespace dynamo {
   IHardSphere::maxIntDist() const 
   { return _diameter->getMaxValue(); }
 
+  double 
+  IHardSphere::particleMaxIntDist(size_t ID) const
+  { return _diameter->getProperty(ID); }
+
   double 
   IHardSphere::getExcludedVolume(size_t ID) const 
   { 
@@ -65,6 +65,8 @@ namespace dynamo {
 
     virtual double maxIntDist() const;
 
+    virtual double particleMaxIntDist(size_t ID) const;
+
     virtual double getExcludedVolume(size_t) const;
 
     virtual void rescaleLengths(double) {}
@@ -85,6 +85,17 @@ namespace dynamo {
     */
     virtual double maxIntDist() const = 0;  
 
+    /*! \brief Return the maximum distance at which a particular
+      particle may interact with any other using this Interaction.
+
+      This is used by neighbour lists which sort particles by their
+      interaction range (e.g., GCellsHierarchical). For any pair of
+      particles, the interaction distance must not exceed the larger
+      of their two values. The default implementation returns
+      maxIntDist().
+    */
+    virtual double particleMaxIntDist(size_t ID) const { return maxIntDist(); }
+
     /*! \brief Returns the internal energy "stored" in this interaction.
      */
     virtual double getInternalEnergy() const { return 0; }
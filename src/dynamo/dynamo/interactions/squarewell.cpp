@@ -73,6 +73,10 @@ namespace dynamo {
   ISquareWell::maxIntDist() const 
   { return _diameter->getMaxValue() * _lambda->getMaxValue(); }
 
+  double 
+  ISquareWell::particleMaxIntDist(size_t ID) const
+  { return _diameter->getProperty(ID) * _lambda->getMaxValue(); }
+
   void 
   ISquareWell::initialise(size_t nID)
   {
@@ -44,6 +44,8 @@ namespace dynamo {
 
     virtual double maxIntDist() const;
 
+    virtual double particleMaxIntDist(size_t ID) const;
+
     virtual size_t captureTest(const Particle&, const Particle&) const;
 
     virtual void initialise(size_t);
@@ -32,6 +32,13 @@ namespace dynamo {
   OPCollMatrix::initialise()
   {
     lastEvent.resize(Sim->N(), lastEventData(Sim->systemTime, eventKey(classKey(0, NOSOURCE), NONE)));
+
+    //Every event which changes a particle is collected
+    unsubscribeEvents();
+    subscribeEvents(INTERACTION);
+    subscribeEvents(LOCAL);
+    subscribeEvents(GLOBAL);
+    subscribeEvents(SYSTEM);
   }
 
   OPCollMatrix::~OPCollMatrix()
@@ -51,20 +51,28 @@ namespace dynamo {
     _next_map_id = 0;
     _weight = 0;
     _total_weight = 0;
+    _last_update = Sim->systemTime;
   
     _interaction = std::dynamic_pointer_cast<ICapture>(Sim->interactions[_interaction_name]);
 
     if (!_interaction)
       M_throw() << "Could not cast \"" << _interaction_name << "\" to an ICapture type to build the contact map";
+
+    //Only changes in the captured pairs alter the map, the time
+    //spent in each map is found from the system time when it changes
+    unsubscribeEvents();
+    subscribeEvents(INTERACTION, STEP_IN, _interaction->getID());
+    subscribeEvents(INTERACTION, STEP_OUT, _interaction->getID());
     
     _current_map = _collected_maps.insert(CollectedMapType::value_type(*_interaction, MapData(Sim->systemTime, Sim->calcInternalEnergy(), _next_map_id++))).first;
   }
 
-  void OPContactMap::stream(double dt) { _weight += dt; }
-
   void 
   OPContactMap::flush()
   {
+    _weight += Sim->systemTime - _last_update;
+    _last_update = Sim->systemTime;
+
     //Cannot create new maps here, as flush may happen when the output plugins are invalid
     MapData& data = _current_map->second;
     data._weight += _weight;
@@ -81,15 +89,8 @@ namespace dynamo {
   }
 
   void 
-  OPContactMap::eventUpdate(const Event &event, const NEventData&) 
-  {
-    stream(event._dt);
-    if (event._source != INTERACTION) return;
-
-    if (event._sourceID == _interaction->getID())
-      if ((event._type == STEP_IN) || (event._type == STEP_OUT))
-	mapChanged(true);
-  }
+  OPContactMap::eventUpdate(const Event&, const NEventData&) 
+  { mapChanged(true); }
 
   void 
   OPContactMap::mapChanged(bool addLink) {
@@ -113,6 +114,8 @@ namespace dynamo {
     OPContactMap& op = static_cast<OPContactMap&>(otherplugin);
     
     std::swap(_weight, op._weight);
+    //The system times have already been exchanged
+    std::swap(_last_update, op._last_update);
     std::swap(_total_weight, op._total_weight);
     std::swap(_next_map_id, op._next_map_id);
     std::swap(_collected_maps, op._collected_maps);
@@ -49,12 +49,13 @@ namespace dynamo {
     void periodicOutput();
 
   private:
-    void stream(double);
     void flush();
     
     void mapChanged(bool addLink);
 
     double _weight;
+    //! \brief The system time at which _weight was last updated.
+    double _last_update;
     double _total_weight;
     /*! \brief A sorted listing of all the captured pairs in the
      system
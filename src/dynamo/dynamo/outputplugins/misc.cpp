@@ -577,6 +577,8 @@ namespace dynamo {
 	<< attr("MaxKiloBytes") << magnet::process_mem_usage()
 	<< endtag("Memusage");
 
+    Sim->ptrScheduler->getSorter()->outputData(XML, Sim->units.unitTime());
+
     if (!std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs)) {
       XML << tag("ThermalConductivity") << tag("Correlator");
 
@@ -24,7 +24,7 @@
 namespace dynamo {
   OPMSD::OPMSD(const dynamo::Simulation* tmp, const magnet::xml::Node&):
     OutputPlugin(tmp,"MSD")
-  {}
+  { unsubscribeEvents(); }
 
   OPMSD::~OPMSD()
   {}
@@ -111,7 +111,7 @@ namespace dynamo {
 	double totmass = 0.0;
 	for (const unsigned long& ID : *molRange)
 	  {
-	    double pmass = Sim->species[Sim->particles[ID]]->getMass(ID);
+	    double pmass = Sim->species(Sim->particles[ID])->getMass(ID);
 
 	    totmass += pmass;
 	    currPos += Sim->particles[ID].getPosition() * pmass;
@@ -27,7 +27,7 @@ namespace dynamo {
   OPMSDOrientational::OPMSDOrientational(const dynamo::Simulation* tmp, 
 					 const magnet::xml::Node&):
     OutputPlugin(tmp,"MSDOrientational")
-  {}
+  { unsubscribeEvents(); }
 
   OPMSDOrientational::~OPMSDOrientational()
   {}
@@ -25,7 +25,8 @@
 namespace dynamo {
   OutputPlugin::OutputPlugin(const dynamo::Simulation* tmp, const char *aName, unsigned char order):
     SimBase_const(tmp, aName),
-    updateOrder(order)
+    updateOrder(order),
+    _allEvents(true)
   {
     dout << "Loaded" << std::endl;
   }
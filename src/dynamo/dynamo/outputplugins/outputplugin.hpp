@@ -18,6 +18,7 @@
 #pragma once
 #include <dynamo/base.hpp>
 #include <dynamo/eventtypes.hpp>
+#include <vector>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
@@ -58,8 +59,57 @@ namespace dynamo {
     }
   
     virtual void temperatureRescale(const double&) {}
+
+    /*! \brief A description of a class of events consumed by an
+        OutputPlugin.
+
+	A _source of NOSOURCE, a _type of NONE, or a _sourceID of
+	std::numeric_limits<size_t>::max() act as wildcards and match
+	any event.
+     */
+    struct EventSubscription
+    {
+      EventSubscription(EventSource source, EEventType type, size_t sourceID):
+	_source(source), _type(type), _sourceID(sourceID) {}
+
+      EventSource _source;
+      EEventType _type;
+      size_t _sourceID;
+    };
+
+    /*! \brief Returns true if this plugin must receive every executed
+        event in eventUpdate().
+     */
+    bool consumesAllEvents() const { return _allEvents; }
+
+    /*! \brief The events this plugin consumes (only valid if \ref
+        consumesAllEvents() is false).
+    */
+    const std::vector<EventSubscription>& getEventSubscriptions() const { return _subscriptions; }
   
   protected:
+    /*! \brief Declares that this plugin does not require any calls to
+        eventUpdate().
+
+	By default, a plugin consumes all events. This must be called
+	in the constructor or initialise(), as the Scheduler builds its
+	event dispatch table after the OutputPlugin's are initialised.
+     */
+    void unsubscribeEvents() { _allEvents = false; _subscriptions.clear(); }
+
+    /*! \brief Declares a class of events which must be passed to
+        eventUpdate().
+
+	The first call to this function restricts the plugin to only
+	receive the events it has subscribed to. This must be called in
+	the constructor or initialise() (see \ref unsubscribeEvents()).
+     */
+    void subscribeEvents(EventSource source, EEventType type = NONE, size_t sourceID = std::numeric_limits<size_t>::max())
+    {
+      if (_allEvents) unsubscribeEvents();
+      _subscriptions.push_back(EventSubscription(source, type, sourceID));
+    }
+
     std::ostream& I_Pcout() const;
   
     // This sets the order in which these things are updated
@@ -69,5 +119,9 @@ namespace dynamo {
     //
     // Lets other plugins take data from plugins before/after they are updated
     unsigned char updateOrder;
+
+  private:
+    bool _allEvents;
+    std::vector<EventSubscription> _subscriptions;
   };
 }
@@ -48,6 +48,8 @@ namespace dynamo {
   {
     if (XML.hasAttribute("binwidth"))
       binwidth = XML.getAttribute("binwidth").as<double>();
+
+    loadAnalysisOptions(XML);
   }
 
   void 
@@ -62,36 +64,41 @@ namespace dynamo {
   void 
   OPChainBondAngles::ticker()
   {
-    for (Cdata& dat : chains)
-      for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
-      if (range->size() > 2)
-	{
-	  //Walk the polymer
-	  for (size_t j = 0; j < range->size()-2; ++j)
-	    {
-	      Vector  bond1 = Sim->particles[(*range)[j+1]].getPosition()
-		- Sim->particles[(*range)[j]].getPosition();
-
-	      bond1 /= bond1.nrm();
-
-	      for (size_t i = j+2; i < range->size(); ++i)
-		{
-		  Vector  bond2 = Sim->particles[(*range)[i]].getPosition()
-		    -Sim->particles[(*range)[i-1]].getPosition();
-		
-		  bond2 /= bond2.nrm();
-		
-		  dat.BondCorrelations[i-j-2].addVal(bond1 | bond2);
-		  dat.BondCorrelationsAvg[i-j-2] += (bond1 | bond2);
-		  ++(dat.BondCorrelationsSamples[i-j-2]);
-		}
-	    }
-	}
+    const shared_ptr<const Snapshot> snapshot = takeSnapshot(true, false);
+
+    runAnalysis([this, snapshot]() {
+	const std::vector<Vector>& pos = snapshot->positions;
+	for (Cdata& dat : chains)
+	  for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
+	    if (range->size() > 2)
+	      {
+		//Walk the polymer
+		for (size_t j = 0; j < range->size()-2; ++j)
+		  {
+		    Vector  bond1 = pos[(*range)[j+1]] - pos[(*range)[j]];
+		    
+		    bond1 /= bond1.nrm();
+		    
+		    for (size_t i = j+2; i < range->size(); ++i)
+		      {
+			Vector  bond2 = pos[(*range)[i]] - pos[(*range)[i-1]];
+			
+			bond2 /= bond2.nrm();
+			
+			dat.BondCorrelations[i-j-2].addVal(bond1 | bond2);
+			dat.BondCorrelationsAvg[i-j-2] += (bond1 | bond2);
+			++(dat.BondCorrelationsSamples[i-j-2]);
+		      }
+		  }
+	      }
+      });
   }
 
   void 
   OPChainBondAngles::output(magnet::xml::XmlStream& XML)
   {
+    joinAnalysis();
+
     XML << magnet::xml::tag("BondAngleCorrelators");
   
     for (Cdata& dat : chains)
@@ -27,6 +27,8 @@ namespace dynamo {
   public:
     OPChainBondAngles(const dynamo::Simulation*, const magnet::xml::Node&);
 
+    ~OPChainBondAngles() { stopAnalysis(); }
+
     virtual void initialise();
 
     virtual void stream(double) {}
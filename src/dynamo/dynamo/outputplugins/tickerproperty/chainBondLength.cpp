@@ -32,9 +32,11 @@ namespace dynamo {
     BondLengths.resize(CL-1, magnet::math::Histogram<>(0.0001));
   }
 
-  OPChainBondLength::OPChainBondLength(const dynamo::Simulation* tmp, const magnet::xml::Node&):
+  OPChainBondLength::OPChainBondLength(const dynamo::Simulation* tmp, const magnet::xml::Node& XML):
     OPTicker(tmp,"ChainBondLength")
-  {}
+  {
+    loadAnalysisOptions(XML);
+  }
 
   void 
   OPChainBondLength::initialise()
@@ -47,19 +49,24 @@ namespace dynamo {
   void 
   OPChainBondLength::ticker()
   {
-    for (Cdata& dat : chains)
-      for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
-      if (range->size() > 2)
-	//Walk the polymer
-	for (size_t j = 0; j < range->size()-1; ++j)
-	  dat.BondLengths[j].addVal
-	    ((Sim->particles[(*range)[j+1]].getPosition()
-	      - Sim->particles[(*range)[j]].getPosition()).nrm());
+    const shared_ptr<const Snapshot> snapshot = takeSnapshot(true, false);
+
+    runAnalysis([this, snapshot]() {
+	const std::vector<Vector>& pos = snapshot->positions;
+	for (Cdata& dat : chains)
+	  for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
+	    if (range->size() > 2)
+	      //Walk the polymer
+	      for (size_t j = 0; j < range->size()-1; ++j)
+		dat.BondLengths[j].addVal((pos[(*range)[j+1]] - pos[(*range)[j]]).nrm());
+      });
   }
 
   void 
   OPChainBondLength::output(magnet::xml::XmlStream& XML)
   {
+    joinAnalysis();
+
     XML << magnet::xml::tag("BondAngleLength");
   
     for (Cdata& dat : chains)
@@ -27,6 +27,8 @@ namespace dynamo {
   public:
     OPChainBondLength(const dynamo::Simulation*, const magnet::xml::Node&);
 
+    ~OPChainBondLength() { stopAnalysis(); }
+
     virtual void initialise();
 
     virtual void stream(double) {}
@@ -40,6 +40,8 @@ namespace dynamo {
   {
     if (XML.hasAttribute("Length"))
       length = XML.getAttribute("Length").as<size_t>();
+
+    loadAnalysisOptions(XML);
   }
 
   void 
@@ -54,23 +56,31 @@ namespace dynamo {
 
     speciesData.resize(Sim->species.size(), std::vector<double>(length, 0.0));
     structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
+
+    _masses.clear();
+    for (const Particle& part : Sim->particles)
+      _masses.push_back(Sim->species(part)->getMass(part.getID()));
   }
 
   void 
   OPMSDCorrelator::ticker()
   {
-    for (const Particle& part : Sim->particles)
-      posHistory[part.getID()].push_front(part.getPosition());
-  
-    if (notReady)
-      {
-	if (++currCorrLength != length)
-	  return;
-      
-	notReady = false;
-      }
-  
-    accPass();
+    const shared_ptr<const Snapshot> snapshot = takeSnapshot(true, false);
+
+    runAnalysis([this, snapshot]() {
+	for (size_t ID(0); ID < snapshot->positions.size(); ++ID)
+	  posHistory[ID].push_front(snapshot->positions[ID]);
+	
+	if (notReady)
+	  {
+	    if (++currCorrLength != length)
+	      return;
+	    
+	    notReady = false;
+	  }
+	
+	accPass();
+      });
   }
 
   void
@@ -91,7 +101,7 @@ namespace dynamo {
 
 	for (const size_t& ID : *range)
 	  {
-	    double mass = Sim->species[Sim->particles[ID]]->getMass(ID);
+	    double mass = _masses[ID];
 	    molCOM += posHistory[ID][0] * mass;
 	    molMass += mass;
 	  }
@@ -104,7 +114,7 @@ namespace dynamo {
 	  
 	    for (const size_t& ID : *range)
 	      molCOM2 += posHistory[ID][step] 
-	      * Sim->species[Sim->particles[ID]]->getMass(ID);
+	      * _masses[ID];
 	  
 	    molCOM2 /= molMass;
 	  
@@ -116,6 +126,8 @@ namespace dynamo {
   void
   OPMSDCorrelator::output(magnet::xml::XmlStream &XML)
   {
+    joinAnalysis();
+
     XML << magnet::xml::tag("MSDCorrelator")
 	<< magnet::xml::tag("Particles");
   
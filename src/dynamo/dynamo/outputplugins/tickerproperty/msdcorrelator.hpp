@@ -27,6 +27,8 @@ namespace dynamo {
   public:
     OPMSDCorrelator(const dynamo::Simulation*, const magnet::xml::Node&);
 
+    ~OPMSDCorrelator() { stopAnalysis(); }
+
     virtual void initialise();
 
     void output(magnet::xml::XmlStream &); 
@@ -42,6 +44,9 @@ namespace dynamo {
     std::vector<boost::circular_buffer<Vector> > posHistory;
     std::vector<std::vector<double> > speciesData;
     std::vector<std::vector<double> > structData;
+    /*! \brief The particle masses, cached so that accPass() does not
+        read the particle data from the analysis thread. */
+    std::vector<double> _masses;
     size_t length;
     size_t currCorrLength;
     size_t ticksTaken;
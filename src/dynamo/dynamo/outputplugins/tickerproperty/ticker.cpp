@@ -19,11 +19,65 @@
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
 #include <dynamo/include.hpp>
 #include <dynamo/systems/sysTicker.hpp>
+#include <magnet/xmlreader.hpp>
 
 namespace dynamo {
   OPTicker::OPTicker(const dynamo::Simulation* t1,const char *t2):
     OutputPlugin(t1,t2)
-  {}
+  {
+    //Ticker plugins are driven by the SysTicker, not by events
+    unsubscribeEvents();
+  }
+
+  void
+  OPTicker::loadAnalysisOptions(const magnet::xml::Node& XML)
+  {
+    if (XML.hasAttribute("Background"))
+      {
+	dout << "Analysis will be performed on a background thread" << std::endl;
+	_analysisThread.reset(new magnet::thread::ThreadPool);
+	//A single worker thread keeps the tasks in order
+	_analysisThread->setThreadCount(1);
+      }
+  }
+
+  shared_ptr<const OPTicker::Snapshot>
+  OPTicker::takeSnapshot(bool positions, bool velocities) const
+  {
+    shared_ptr<Snapshot> snapshot(new Snapshot);
+    
+    if (positions)
+      {
+	snapshot->positions.reserve(Sim->N());
+	for (const Particle& part : Sim->particles)
+	  snapshot->positions.push_back(part.getPosition());
+      }
+
+    if (velocities)
+      {
+	snapshot->velocities.reserve(Sim->N());
+	for (const Particle& part : Sim->particles)
+	  snapshot->velocities.push_back(part.getVelocity());
+      }
+
+    return snapshot;
+  }
+
+  void
+  OPTicker::runAnalysis(const std::function<void()>& task)
+  {
+    if (_analysisThread)
+      _analysisThread->queueTask(task);
+    else
+      task();
+  }
+
+  void
+  OPTicker::joinAnalysis()
+  {
+    if (_analysisThread)
+      _analysisThread->wait();
+  }
 
   double 
   OPTicker::getTickerTime() const
@@ -17,6 +17,11 @@
 
 #pragma once
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <magnet/math/vector.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace dynamo {
   /*! \brief An output plugin marker class for periodically 'ticked'
@@ -25,6 +30,14 @@ namespace dynamo {
    * This class doesn't require any Dynamics::updateParticle or
    * Dynamics::updateAllParticles as this is done in the SysTicker
    * class. This is optimal as most ticker plugins need it anyway
+   *
+   * Plugins may also offload their analysis onto a background
+   * thread (enabled using the "Background" option). The plugin
+   * copies the particle data it needs at the ticker time using
+   * takeSnapshot() and passes the analysis to runAnalysis(), which
+   * executes the tasks in order on a single worker thread. The
+   * results are therefore identical to the inline execution, but
+   * the event loop only pays for the copy.
    */
   class OPTicker: public OutputPlugin
   {
@@ -43,8 +56,55 @@ namespace dynamo {
     virtual void replicaExchange(OutputPlugin&)
     { M_throw() << "This System type hasn't been prepared for changes of system"; }
 
+    //! \brief If the analysis is run on a background thread.
+    bool backgroundAnalysis() const { return bool(_analysisThread); }
+
   protected:
 
     double getTickerTime() const;
+
+    /*! \brief A copy of the particle state at the ticker time. */
+    struct Snapshot
+    {
+      std::vector<Vector> positions;
+      std::vector<Vector> velocities;
+    };
+
+    /*! \brief Copy the positions and/or velocities of all particles.
+     */
+    shared_ptr<const Snapshot> takeSnapshot(bool positions, bool velocities) const;
+
+    /*! \brief Enables background analysis if the "Background"
+        attribute is present.
+     */
+    void loadAnalysisOptions(const magnet::xml::Node&);
+
+    /*! \brief Executes an analysis task, either immediately or on
+        the background analysis thread.
+
+	Background tasks must only access the data passed to them
+	(e.g., a Snapshot), data owned by the plugin, and parts of the
+	Simulation which do not change during a run (e.g., the
+	Species and Topology definitions).
+     */
+    void runAnalysis(const std::function<void()>& task);
+
+    /*! \brief Waits for all outstanding analysis tasks to complete.
+
+	This must be called before the results of the analysis are
+	read (e.g., in output()).
+     */
+    void joinAnalysis();
+
+    /*! \brief Terminates the background analysis thread, discarding
+        any queued tasks.
+
+	This must be called in the destructor of derived classes which
+	use runAnalysis(), as the queued tasks reference their data.
+     */
+    void stopAnalysis() { _analysisThread.reset(); }
+
+  private:
+    std::unique_ptr<magnet::thread::ThreadPool> _analysisThread;
   };
 }
@@ -40,6 +40,8 @@ namespace dynamo {
   {
     if (XML.hasAttribute("Length"))
       length = XML.getAttribute("Length").as<size_t>();
+
+    loadAnalysisOptions(XML);
   }
 
   void 
@@ -56,21 +58,29 @@ namespace dynamo {
     
     speciesData.resize(Sim->species.size(), std::vector<double>(length, 0.0));
     structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
+
+    _masses.clear();
+    for (const Particle& part : Sim->particles)
+      _masses.push_back(Sim->species(part)->getMass(part.getID()));
   }
 
   void 
   OPVACF::ticker()
   {
-    for (const Particle& part : Sim->particles)
-      velHistory[part.getID()].push_front(part.getVelocity());
-  
-    if (notReady)
-      {
-	if (++currCorrLength != length) return;
-	notReady = false;
-      }
-    
-    accPass();
+    const shared_ptr<const Snapshot> snapshot = takeSnapshot(false, true);
+
+    runAnalysis([this, snapshot]() {
+	for (size_t ID(0); ID < snapshot->velocities.size(); ++ID)
+	  velHistory[ID].push_front(snapshot->velocities[ID]);
+	
+	if (notReady)
+	  {
+	    if (++currCorrLength != length) return;
+	    notReady = false;
+	  }
+	
+	accPass();
+      });
   }
 
   void
@@ -91,7 +101,7 @@ namespace dynamo {
 	  
 	  for (const size_t& ID : *range)
 	    {
-	      double mass = Sim->species[Sim->particles[ID]]->getMass(ID);
+	      double mass = _masses[ID];
 	      COMvelocity += velHistory[ID][0] * mass;
 	      molMass += mass;
 	    }
@@ -103,7 +113,7 @@ namespace dynamo {
 	      Vector COMvelocity2({0,0,0});
 	      
 	      for (const size_t& ID : *range)
-		COMvelocity2 += velHistory[ID][step] * Sim->species[Sim->particles[ID]]->getMass(ID);
+		COMvelocity2 += velHistory[ID][step] * _masses[ID];
 	      COMvelocity2 /= molMass;
 	      structData[topo->getID()][step] += COMvelocity | COMvelocity2;
 	    }
@@ -113,6 +123,8 @@ namespace dynamo {
   void
   OPVACF::output(magnet::xml::XmlStream &XML)
   {
+    joinAnalysis();
+
     XML << magnet::xml::tag("VACF")
 	<< magnet::xml::tag("Particles");
   
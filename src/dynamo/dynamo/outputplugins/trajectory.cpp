@@ -19,79 +19,134 @@
 #include <dynamo/NparticleEventData.hpp>
 #include <dynamo/systems/system.hpp>
 #include <dynamo/BC/BC.hpp>
-#include <iomanip>
+#include <magnet/xmlreader.hpp>
 
 namespace dynamo {
-  OPTrajectory::OPTrajectory(const dynamo::Simulation* t1, const magnet::xml::Node&):
-    OutputPlugin(t1,"Trajectory")
+  namespace {
+    //The size of the binary output buffer, in bytes
+    const size_t bufferSize = 1 << 22;
+  }
+
+  OPTrajectory::OPTrajectory(const dynamo::Simulation* t1, const magnet::xml::Node& XML):
+    OutputPlugin(t1,"Trajectory"),
+    _binary(XML.hasAttribute("Binary"))
   {}
 
   OPTrajectory::OPTrajectory(const OPTrajectory& trj):
-    OutputPlugin(trj)
+    OutputPlugin(trj),
+    _binary(trj._binary)
   {
     if (trj.logfile.is_open())
       trj.logfile.close();
   }
 
+  OPTrajectory::~OPTrajectory()
+  {
+    try { flush(); }
+    catch (...) {}
+  }
+
   void
   OPTrajectory::initialise()
   {
     if (logfile.is_open())
       logfile.close();
  
-    logfile.open("trajectory.out", std::ios::out|std::ios::trunc);
-    logfile.precision(4);
-    logfile.setf(std::ios::fixed);
+    if (_binary)
+      {
+	logfile.open("trajectory.bin", std::ios::out | std::ios::trunc | std::ios::binary);
+	const trajectory::FileHeader header;
+	logfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	_buffer.reserve(bufferSize);
+      }
+    else
+      {
+	logfile.open("trajectory.out", std::ios::out|std::ios::trunc);
+	trajectory::setTextFormat(logfile);
+      }
+
+    //Every event is logged, including the virtual events
+    unsubscribeEvents();
+    subscribeEvents(INTERACTION);
+    subscribeEvents(LOCAL);
+    subscribeEvents(GLOBAL);
+    subscribeEvents(SYSTEM);
+  }
+
+  void
+  OPTrajectory::flush()
+  {
+    if (_buffer.empty() || !logfile.is_open()) return;
+    logfile.write(_buffer.data(), _buffer.size());
+    logfile.flush();
+    _buffer.clear();
   }
 
   void 
   OPTrajectory::eventUpdate(const Event& eevent, const NEventData& SDat)
   {
-    logfile << std::setw(8) << std::setfill('0') << Sim->eventCount 
-	    << ", Source=" <<  eevent._source 
-	    << ", SourceID=" << eevent._sourceID
-	    << ", Event Type=" << eevent._type
-	    << ", t=" << Sim->systemTime / Sim->units.unitTime() 
-	    << ", dt=" << eevent._dt / Sim->units.unitTime()
-      ;
+    trajectory::EventRecord event;
+    event.eventCount = Sim->eventCount;
+    event.sourceID = eevent._sourceID;
+    event.t = Sim->systemTime / Sim->units.unitTime();
+    event.dt = eevent._dt / Sim->units.unitTime();
+    event.source = eevent._source;
+    event.type = eevent._type;
+    event.N1 = SDat.L1partChanges.size();
+    event.N2 = SDat.L2partChanges.size();
 
+    _L1.resize(event.N1);
+    size_t i(0);
     for (const ParticleEventData& pData : SDat.L1partChanges)
       {
-	logfile << "\n";
 	const Particle& part = Sim->particles[pData.getParticleID()];
-	logfile << "   1PEvent: p1=" << part.getID() << ", Type=" << pData.getType();
-	Vector delP = Sim->species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
-	delP /= Sim->units.unitMomentum();
-	Vector pos = part.getPosition() / Sim->units.unitLength();
-	Vector oldv = pData.getOldVel() / Sim->units.unitVelocity();
-	Vector newv = part.getVelocity() / Sim->units.unitVelocity();
-	logfile << ", delP1=" << delP.toString() << ", pos=" << pos.toString() << ", vel=" << newv.toString() << ", oldvel=" << oldv.toString() << "\n";
+	trajectory::ParticleRecord& record = _L1[i++];
+	record.ID = part.getID();
+	record.type = pData.getType();
+	record.padding = 0;
+	const Vector delP = Sim->species[pData.getSpeciesID()]->getMass(part.getID()) * (part.getVelocity() - pData.getOldVel());
+	trajectory::store(record.delP, delP / Sim->units.unitMomentum());
+	trajectory::store(record.pos, part.getPosition() / Sim->units.unitLength());
+	trajectory::store(record.vel, part.getVelocity() / Sim->units.unitVelocity());
+	trajectory::store(record.oldvel, pData.getOldVel() / Sim->units.unitVelocity());
       }
   
+    _L2.resize(event.N2);
+    i = 0;
     for (const PairEventData& pData : SDat.L2partChanges)
       {
+	trajectory::PairRecord& record = _L2[i++];
 	const size_t id1 = std::min(pData.particle1_.getParticleID(), pData.particle2_.getParticleID());
 	const size_t id2 = std::max(pData.particle1_.getParticleID(), pData.particle2_.getParticleID());
 	Vector  rij = Sim->particles[id1].getPosition() - Sim->particles[id2].getPosition(),
 	  vij = Sim->particles[id1].getVelocity() - Sim->particles[id2].getVelocity();
 	
 	Sim->BCs->applyBC(rij, vij);
-	rij /= Sim->units.unitLength();
-	vij /= Sim->units.unitVelocity();
-	
-	logfile << "\n   2PEvent:";
-	logfile << " p1=" << std::setw(5) << id1
-		<< ", p2=" << std::setw(5) << id2
-		<< ", delP1=" << ((id1 == pData.particle1_.getParticleID()) ? pData.impulse.toString() : (-pData.impulse).toString())
-		<< ", |r12|=" << std::setw(5) << rij.nrm()
-		<< ", post-r12=" << rij.toString()
-		<< ", post-v12=" << vij.toString()
-		<< ", post-rvdot=" << (vij | rij);
+	record.ID1 = id1;
+	record.ID2 = id2;
+	trajectory::store(record.delP1, (id1 == pData.particle1_.getParticleID()) ? pData.impulse : Vector(-pData.impulse));
+	trajectory::store(record.r12, rij / Sim->units.unitLength());
+	trajectory::store(record.v12, vij / Sim->units.unitVelocity());
+      }
+
+    if (!_binary)
+      {
+	trajectory::writeText(logfile, event, _L1.data(), _L2.data());
+	return;
       }
-    logfile << "\n";
+
+    const char* data = reinterpret_cast<const char*>(&event);
+    _buffer.insert(_buffer.end(), data, data + sizeof(event));
+    data = reinterpret_cast<const char*>(_L1.data());
+    _buffer.insert(_buffer.end(), data, data + sizeof(trajectory::ParticleRecord) * event.N1);
+    data = reinterpret_cast<const char*>(_L2.data());
+    _buffer.insert(_buffer.end(), data, data + sizeof(trajectory::PairRecord) * event.N2);
+
+    if (_buffer.size() >= bufferSize)
+      flush();
   }
   
   void 
   OPTrajectory::output(magnet::xml::XmlStream& XML)
-  {}
+  { flush(); }
 }
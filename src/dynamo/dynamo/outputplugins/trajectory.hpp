@@ -17,9 +17,19 @@
 
 #pragma once
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/outputplugins/trajectoryformat.hpp>
 #include <fstream>
+#include <vector>
 
 namespace dynamo {
+  /*! \brief Writes a log of every event and the changes it caused.
+
+    By default this is written as text to "trajectory.out". If the
+    "Binary" option is set, fixed size records (see
+    trajectoryformat.hpp) are collected in a large buffer and written
+    to "trajectory.bin". These can be converted to the text form using
+    the dynatraj program.
+   */
   class OPTrajectory: public OutputPlugin
   {
   public:
@@ -27,7 +37,7 @@ namespace dynamo {
 
     OPTrajectory(const OPTrajectory&);
   
-    ~OPTrajectory() {}
+    ~OPTrajectory();
 
     void eventUpdate(const Event&, const NEventData&);
 
@@ -39,7 +49,13 @@ namespace dynamo {
     virtual void output(magnet::xml::XmlStream&);
 
   private:
+    void flush();
 
     mutable std::ofstream logfile;
+
+    bool _binary;
+    std::vector<trajectory::ParticleRecord> _L1;
+    std::vector<trajectory::PairRecord> _L2;
+    std::vector<char> _buffer;
   };
 }
@@ -0,0 +1,183 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file trajectoryformat.hpp
+  \brief The record layout of the binary trajectory files written
+  by OPTrajectory, and the conversion of these records to the text
+  trajectory format.
+ */
+
+#pragma once
+#include <dynamo/eventtypes.hpp>
+#include <magnet/math/vector.hpp>
+#include <magnet/exception.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+namespace dynamo {
+  namespace trajectory {
+    /*! \brief The header at the start of every binary trajectory
+        file.
+
+	The records which follow are written in the native byte order
+	and the files are therefore not portable between
+	architectures.
+     */
+    struct FileHeader
+    {
+      FileHeader():
+	version(1), ndim(NDIM)
+      { std::memcpy(magic, "DYNTRJ\0\0", 8); }
+
+      char magic[8];
+      uint32_t version;
+      uint32_t ndim;
+
+      bool valid() const
+      { return !std::memcmp(magic, "DYNTRJ\0\0", 8) && (version == 1) && (ndim == NDIM); }
+    };
+
+    /*! \brief The fixed size record written for each event.
+
+	It is followed by N1 ParticleRecord's and N2 PairRecord's.
+	All quantities are stored in reduced units.
+     */
+    struct EventRecord
+    {
+      uint64_t eventCount;
+      uint64_t sourceID;
+      double t;
+      double dt;
+      uint32_t source;
+      uint32_t type;
+      uint32_t N1;
+      uint32_t N2;
+    };
+
+    /*! \brief The record of a single particle change in an event. */
+    struct ParticleRecord
+    {
+      uint64_t ID;
+      uint32_t type;
+      uint32_t padding;
+      double delP[NDIM];
+      double pos[NDIM];
+      double vel[NDIM];
+      double oldvel[NDIM];
+    };
+
+    /*! \brief The record of a pair change in an event.
+
+	The ID's are sorted (ID1 < ID2) and delP1 is the impulse on
+	particle ID1. The separation and relative velocity are taken
+	after the event with the boundary conditions applied.
+     */
+    struct PairRecord
+    {
+      uint64_t ID1;
+      uint64_t ID2;
+      double delP1[NDIM];
+      double r12[NDIM];
+      double v12[NDIM];
+    };
+
+    inline void store(double* dest, const Vector& vec)
+    { for (size_t i(0); i < NDIM; ++i) dest[i] = vec[i]; }
+
+    inline Vector load(const double* src)
+    {
+      Vector vec;
+      for (size_t i(0); i < NDIM; ++i) vec[i] = src[i];
+      return vec;
+    }
+
+    /*! \brief Configures a stream to write the text trajectory
+        format.
+     */
+    inline void setTextFormat(std::ostream& os)
+    {
+      os.precision(4);
+      os.setf(std::ios::fixed);
+    }
+
+    /*! \brief Writes an event in the text trajectory format.
+
+	The stream must have been configured using setTextFormat().
+     */
+    inline void writeText(std::ostream& os, const EventRecord& event, const ParticleRecord* L1, const PairRecord* L2)
+    {
+      os << std::setw(8) << std::setfill('0') << event.eventCount
+	 << ", Source=" << EventSource(event.source)
+	 << ", SourceID=" << event.sourceID
+	 << ", Event Type=" << EEventType(event.type)
+	 << ", t=" << event.t
+	 << ", dt=" << event.dt;
+
+      for (const ParticleRecord* pData = L1; pData != L1 + event.N1; ++pData)
+	os << "\n"
+	   << "   1PEvent: p1=" << pData->ID << ", Type=" << EEventType(pData->type)
+	   << ", delP1=" << load(pData->delP).toString()
+	   << ", pos=" << load(pData->pos).toString()
+	   << ", vel=" << load(pData->vel).toString()
+	   << ", oldvel=" << load(pData->oldvel).toString() << "\n";
+
+      for (const PairRecord* pData = L2; pData != L2 + event.N2; ++pData)
+	{
+	  const Vector rij = load(pData->r12);
+	  const Vector vij = load(pData->v12);
+	  os << "\n   2PEvent:";
+	  os << " p1=" << std::setw(5) << pData->ID1
+	     << ", p2=" << std::setw(5) << pData->ID2
+	     << ", delP1=" << load(pData->delP1).toString()
+	     << ", |r12|=" << std::setw(5) << rij.nrm()
+	     << ", post-r12=" << rij.toString()
+	     << ", post-v12=" << vij.toString()
+	     << ", post-rvdot=" << (vij | rij);
+	}
+      os << "\n";
+    }
+
+    /*! \brief Reads a binary trajectory and writes it in the text
+        trajectory format.
+     */
+    inline void convertToText(std::istream& in, std::ostream& out)
+    {
+      FileHeader header;
+      in.read(reinterpret_cast<char*>(&header), sizeof(header));
+      if (!in || !header.valid())
+	M_throw() << "Not a binary trajectory file, or it was written with a different NDIM/version";
+
+      setTextFormat(out);
+
+      std::vector<ParticleRecord> L1;
+      std::vector<PairRecord> L2;
+      EventRecord event;
+      while (in.read(reinterpret_cast<char*>(&event), sizeof(event)))
+	{
+	  L1.resize(event.N1);
+	  L2.resize(event.N2);
+	  in.read(reinterpret_cast<char*>(L1.data()), sizeof(ParticleRecord) * event.N1);
+	  in.read(reinterpret_cast<char*>(L2.data()), sizeof(PairRecord) * event.N2);
+	  if (!in)
+	    M_throw() << "Truncated record for event " << event.eventCount;
+	  writeText(out, event, L1.data(), L2.data());
+	}
+    }
+  }
+}
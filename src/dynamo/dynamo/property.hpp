@@ -318,6 +318,9 @@ namespace dynamo {
       _namedProperties.push_back(property);
     }
 
+    //! \brief Returns true if any per-particle properties are stored.
+    inline bool hasParticleProperties() const { return !_namedProperties.empty(); }
+
     inline friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const PropertyStore& propStore)
     {
       XML << magnet::xml::tag("Properties");
@@ -83,6 +83,19 @@ namespace dynamo {
 
     virtual unsigned long at(unsigned long) const = 0;
 
+    /*! \brief Tests if the range is a contiguous block of IDs.
+
+      This allows bulk operations over the particles of a range to
+      loop over them directly, instead of calling operator[] for
+      each ID.
+
+      \param begin Set to the first ID of the block.
+      \param end Set to one past the last ID of the block.
+      \return If the range is contiguous.
+     */
+    virtual bool getContiguousRange(unsigned long& begin, unsigned long& end) const
+    { return false; }
+
     static IDRange* getClass(const magnet::xml::Node&, const dynamo::Simulation * Sim);
 
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML,
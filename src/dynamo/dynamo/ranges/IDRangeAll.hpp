@@ -52,6 +52,13 @@ namespace dynamo {
       return i;
     }
 
+    virtual bool getContiguousRange(unsigned long& begin, unsigned long& end) const
+    {
+      begin = 0;
+      end = Sim->particles.size();
+      return true;
+    }
+
   protected:
 
     void outputXML(magnet::xml::XmlStream& XML) const
@@ -41,6 +41,12 @@ namespace dynamo {
     virtual unsigned long at(unsigned long i) const 
     { M_throw() << "Nothing to access"; }
 
+    virtual bool getContiguousRange(unsigned long& begin, unsigned long& end) const
+    {
+      begin = end = 0;
+      return true;
+    }
+
   protected:
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
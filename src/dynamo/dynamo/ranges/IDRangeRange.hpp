@@ -49,6 +49,13 @@ namespace dynamo {
       return startID + i;
     }
 
+    virtual bool getContiguousRange(unsigned long& begin, unsigned long& end) const
+    {
+      begin = startID;
+      end = endID + 1;
+      return true;
+    }
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream& XML) const
     {
@@ -32,6 +32,7 @@
 #endif
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <algorithm>
 
 namespace dynamo {
   Scheduler::Scheduler(dynamo::Simulation* const tmp, const char * aName,
@@ -317,12 +318,11 @@ namespace dynamo {
 	  //Allow everything to stream up to the current time before executing the event
 	  Sim->stream(Event._dt);
 	  
-	  PairEventData eventdata = Sim->interactions[Event._sourceID]->runEvent(p1, p2, Event);
+	  const NEventData eventdata(Sim->interactions[Event._sourceID]->runEvent(p1, p2, Event));
 	  
 	  Sim->_sigParticleUpdate(eventdata);
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(Event, eventdata);
+	  outputEventUpdate(Event, eventdata);
 	  break;
 	}
       case GLOBAL:
@@ -386,11 +386,10 @@ namespace dynamo {
 	  //dynamics must be updated first
 	  Sim->stream(iEvent._dt);
 	
-	  const ParticleEventData data = Sim->locals[localID]->runEvent(part, iEvent);
+	  const NEventData data(Sim->locals[localID]->runEvent(part, iEvent));
 	  Sim->_sigParticleUpdate(data);	  
 	  Sim->ptrScheduler->fullUpdate(part);
-	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
-	    Ptr->eventUpdate(iEvent, data);
+	  outputEventUpdate(iEvent, data);
 	  break;
 	}
       case SYSTEM:
@@ -420,8 +419,7 @@ namespace dynamo {
 	    for (const auto& d2 : data.L2partChanges)
 	      this->fullUpdate(Sim->particles[d2.particle1_.getParticleID()], Sim->particles[d2.particle2_.getParticleID()]);
 	    
-	    for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
-	      Ptr->eventUpdate(next_event, data);
+	    outputEventUpdate(next_event, data);
 	  }
 
 	  const size_t systemParticleID = Sim->N();
@@ -436,6 +434,54 @@ namespace dynamo {
       }
   }
 
+  void
+  Scheduler::initialiseOutputPluginDispatch()
+  {
+    const size_t ntypes = FINAL_ENUM_TO_CATCH_THE_COMMA;
+    const size_t anyID = std::numeric_limits<size_t>::max();
+
+    _outputPluginDispatch.clear();
+    _outputPluginDispatch.resize((NOSOURCE + 1) * ntypes);
+
+    //The plugins are already sorted by their update order, and this
+    //order is preserved within each list
+    for (const shared_ptr<OutputPlugin>& plugin : Sim->outputPlugins)
+      {
+	if (plugin->consumesAllEvents())
+	  {
+	    for (auto& subscribers : _outputPluginDispatch)
+	      subscribers.push_back(std::make_pair(plugin.get(), anyID));
+	    continue;
+	  }
+
+	for (const OutputPlugin::EventSubscription& sub : plugin->getEventSubscriptions())
+	  for (size_t source(0); source <= NOSOURCE; ++source)
+	    if ((sub._source == NOSOURCE) || (sub._source == source))
+	      for (size_t type(0); type < ntypes; ++type)
+		if ((sub._type == NONE) || (sub._type == type))
+		  {
+		    auto& subscribers = _outputPluginDispatch[source * ntypes + type];
+		    const auto entry = std::make_pair(plugin.get(), sub._sourceID);
+		    if (std::find(subscribers.begin(), subscribers.end(), entry) == subscribers.end())
+		      subscribers.push_back(entry);
+		  }
+      }
+  }
+
+  void
+  Scheduler::outputEventUpdate(const Event& event, const NEventData& data) const
+  {
+    const OutputPlugin* last = nullptr;
+    for (const auto& entry : _outputPluginDispatch[event._source * FINAL_ENUM_TO_CATCH_THE_COMMA + event._type])
+      //A plugin may subscribe to several source IDs of the same
+      //event class, but must only be updated once per event.
+      if ((entry.first != last) && ((entry.second == std::numeric_limits<size_t>::max()) || (entry.second == event._sourceID)))
+	{
+	  entry.first->eventUpdate(event, data);
+	  last = entry.first;
+	}
+  }
+
   void 
   Scheduler::addInteractionEvent(const Particle& part, const size_t& id) const
   {
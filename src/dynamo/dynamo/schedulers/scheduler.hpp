@@ -29,6 +29,8 @@ namespace magnet { namespace xml { class Node; } }
 namespace dynamo {
   class Particle;
   class Event;
+  class NEventData;
+  class OutputPlugin;
   
   class Scheduler: public dynamo::SimBase
   {
@@ -98,6 +100,20 @@ namespace dynamo {
     void addInteractionEvent(const Particle&, const size_t&) const;
     
     void addLocalEvent(const Particle&, const size_t&) const;
+
+    /*! \brief Builds the per-(source, type) lists of OutputPlugin's
+        used to dispatch executed events.
+
+	This must be called after the OutputPlugin's have been
+	initialised, as this is where they declare the events they
+	consume.
+     */
+    void initialiseOutputPluginDispatch();
+
+    /*! \brief Passes an executed event to every OutputPlugin which
+        has subscribed to it.
+     */
+    void outputEventUpdate(const Event&, const NEventData&) const;
     
     
     virtual double getNeighbourhoodDistance() const = 0;
@@ -111,6 +127,11 @@ namespace dynamo {
     size_t _interactionRejectionCounter;
     size_t _localRejectionCounter;
 
+    /*! \brief The subscribed OutputPlugin's (and the source ID they
+        are restricted to) for each (EventSource, EEventType) pair.
+     */
+    std::vector<std::vector<std::pair<OutputPlugin*, size_t> > > _outputPluginDispatch;
+
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
   };
 }
@@ -95,6 +95,12 @@ namespace dynamo {
     virtual void stream(const double) = 0;
     
     virtual Event top() = 0;
+
+    /*! \brief Write any statistics of the FEL into the output XML.
+
+      \param unitTime The simulation unit of time.
+     */
+    virtual void outputData(magnet::xml::XmlStream&, const double unitTime) const {}
  
     static shared_ptr<FEL> getClass(const magnet::xml::Node&);
     friend ::magnet::xml::XmlStream& operator<<(::magnet::xml::XmlStream&, const FEL&);
@@ -21,8 +21,11 @@
 #include <dynamo/units/units.hpp>
 #include <dynamo/simulation.hpp>
 #include <magnet/exception.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <algorithm>
 #include <string>
 #include <vector>
+#include <deque>
 #include <cmath>
 #include <iostream>
 
@@ -37,6 +40,24 @@ namespace dynamo {
     };
   }
 
+  /*! \brief A bounded priority queue (calendar queue) FEL.
+
+      The PELs are sorted into nlists linear lists ("dates") of width
+      1/scale, and only the list of the current date is sorted in a
+      complete binary tree. PELs beyond the last date are placed in an
+      overflow list, which is re-examined every time the calendar
+      wraps.
+
+      The queue tunes itself during the run. The rate of events and
+      the fraction of insertions which overflow are collected over
+      epochs of events, and at the end of each epoch the list width
+      is set to the mean time between events and the number of lists
+      is increased if too many PELs overflow. The PELs are only
+      re-bucketed if the settings change significantly; the event
+      lists themselves are never rebuilt. Small systems (or systems
+      with degenerate statistics) are sorted in a single binary tree
+      (scale=0).
+   */
   template<typename PEL>
   class BoundedPQFEL: public CBTFEL<detail::BPQEntry<PEL> >
   {
@@ -50,10 +71,36 @@ namespace dynamo {
     double scale;
     size_t nlists;
     size_t exceptionCount;
-    size_t _optimizeCounter;
+
+    //! \brief A record of a change to the queue settings.
+    struct Retune
+    {
+      size_t event;
+      double listWidth;
+      size_t lists;
+      double eventRate;
+      double overflowFraction;
+    };
+
+    //Tuning statistics of the current epoch
+    size_t _epochEvents;
+    double _epochTime;
+    size_t _epochInserts;
+    size_t _epochOverflows;
+    size_t _tuneInterval;
+
+    size_t _totalEvents;
+    size_t _retunes;
+    //! \brief The most recent changes of the settings.
+    std::deque<Retune> _retuneLog;
+
+    //! \brief The minimum number of particles to use the calendar.
+    static const size_t minCalendarSize = 10;
+    //! \brief The number of retunes which are kept for the output.
+    static const size_t maxRetuneLog = 32;
     
   public:  
-    BoundedPQFEL():exceptionCount(0) {}
+    BoundedPQFEL():exceptionCount(0), _totalEvents(0), _retunes(0) {}
     
     ~BoundedPQFEL() { 
       std::cout << "Exception Events = " << exceptionCount << std::endl;
@@ -65,10 +112,12 @@ namespace dynamo {
       Base::init(N);
       Base::_streamFreq = 100;
 
-      //Start with the FEL in CBT mode
+      //Start with the FEL in CBT mode, until the statistics of the
+      //first epoch are available
       scale=0;
       nlists = 1;
       linearLists.resize(nlists+1, NO_LINK); /*+1 for overflow, NO_LINK for marking empty*/ 
+      _tuneInterval = std::max(N, size_t(1000));
     }
 
     void clear()
@@ -76,11 +125,14 @@ namespace dynamo {
       Base::clear();
       linearLists.clear();
       currentIndex = 0;
-      _optimizeCounter = 1;
+      resetEpoch();
     }
 
     inline void stream(const double ndt) {
       Base::_pecTime += ndt; 
+      _epochTime += ndt;
+      ++_epochEvents;
+      ++_totalEvents;
     }
 
     inline void rescaleTimes(const double factor)
@@ -89,66 +141,138 @@ namespace dynamo {
 	dat.rescaleTimes(factor);
 
       Base::_pecTime *= factor;
+      _epochTime *= factor;
       scale /= factor;
     }
 
+    //! \brief The number of times the queue settings have changed.
+    size_t getRetuneCount() const { return _retunes; }
+
+    //! \brief The width of each linear list (infinite in CBT mode).
+    double getListWidth() const { return nlists / scale; }
+
+    //! \brief The number of linear lists.
+    size_t getListCount() const { return nlists; }
+
+    virtual void outputData(magnet::xml::XmlStream& XML, const double unitTime) const
+    {
+      XML << magnet::xml::tag("EventSorter")
+	  << magnet::xml::attr("Type") << (std::string("BoundedPQ") + PEL::name())
+	  << magnet::xml::attr("ListWidth") << getListWidth() / unitTime
+	  << magnet::xml::attr("Lists") << nlists
+	  << magnet::xml::attr("Retunes") << _retunes
+	  << magnet::xml::attr("OverflowEvents") << exceptionCount;
+
+      for (const Retune& retune : _retuneLog)
+	XML << magnet::xml::tag("Retune")
+	    << magnet::xml::attr("Event") << retune.event
+	    << magnet::xml::attr("ListWidth") << retune.listWidth / unitTime
+	    << magnet::xml::attr("Lists") << retune.lists
+	    << magnet::xml::attr("EventRate") << retune.eventRate * unitTime
+	    << magnet::xml::attr("OverflowFraction") << retune.overflowFraction
+	    << magnet::xml::endtag("Retune");
+
+      XML << magnet::xml::endtag("EventSorter");
+    }
+
   private: 
     virtual void flushChanges(const size_t ID = std::numeric_limits<size_t>::max()) {
       if ((Base::_activeID != ID) && (Base::_activeID !=std::numeric_limits<size_t>::max()))
 	{
-	  ////Optimise the queue settings every 10^6 events or so
-	  //if (!(++_optimizeCounter % 2^20)) {
-	  //  optimiseSettings();
-	  //  return;
-	  //}
-
 	  insertInEventQ(Base::_activeID + 1);
+
+	  if (_epochEvents >= _tuneInterval)
+	    tune();
+
 	  orderNextEvent();
 	}
       Base::_activeID = ID;
     }
 
-    void optimiseSettings() {
-      //Collect statistics on the event list.
-      double minVal(std::numeric_limits<float>::infinity()), maxVal(-std::numeric_limits<float>::infinity());
-      size_t counter(0);
-      
-      for (const auto& dat : Base::_Min)
-	if (!std::isinf(dat.top()._dt))
-	  {
-	    minVal = std::min(minVal, dat.top()._dt);
-	    maxVal = std::max(maxVal, dat.top()._dt);
-	    ++counter;
-	  }
-      
-      if ((counter < 10) || (maxVal < 0) || ((maxVal - minVal) == 0) || (maxVal < minVal))
-	{ //In unusual systems, drop down to a CBT queue
-	  scale = 0;
-	  nlists = 1;
+    void resetEpoch()
+    {
+      _epochEvents = 0;
+      _epochTime = 0;
+      _epochInserts = 0;
+      _epochOverflows = 0;
+    }
+
+    /*! \brief Update the queue settings from the statistics of the
+        last epoch.
+
+	The list width is set to the mean time between events, so
+	that each list holds roughly one event when it is reached. The
+	number of lists is doubled (up to 16 per PEL) if more than a
+	quarter of the insertions overflowed the calendar.
+     */
+    void tune() {
+      const double eventRate = _epochEvents / _epochTime;
+      const double overflowFraction = _epochInserts ? double(_epochOverflows) / _epochInserts : 0;
+
+      double newScale = 0;
+      size_t newLists = 1;
+      if ((Base::_N >= minCalendarSize) && (eventRate > 0) && !std::isinf(eventRate))
+	{
+	  newScale = eventRate;
+	  newLists = (scale == 0) ? Base::_N : nlists;
+	  if ((scale != 0) && (overflowFraction > 0.25))
+	    newLists = std::min(2 * nlists, 16 * Base::_N);
 	}
-      else
+
+      resetEpoch();
+
+      const bool changed = (newLists != nlists) || ((newScale == 0) != (scale == 0))
+	|| ((scale != 0) && ((newScale < 0.5 * scale) || (newScale > 2 * scale)));
+
+      if (!changed)
 	{
-	  scale = counter / (maxVal - minVal);
-	  nlists = Base::_Min.size();
+	  //In CBT mode, the PELs are periodically brought up to date
+	  //to avoid a loss of precision (the calendar does this as it
+	  //wraps).
+	  if (scale == 0)
+	    {
+	      for (auto& dat : Base::_Min)
+		dat.stream(Base::_pecTime);
+	      Base::_pecTime = 0;
+	    }
+	  return;
 	}
 
-      //Mark all PELs as uninserted
+      scale = newScale;
+      nlists = newLists;
+      ++_retunes;
+      _retuneLog.push_back(Retune{_totalEvents, getListWidth(), nlists, eventRate, overflowFraction});
+      if (_retuneLog.size() > maxRetuneLog)
+	_retuneLog.pop_front();
+
+      rebucket();
+    }
+
+    /*! \brief Re-insert every PEL into the lists, using the current
+        settings.
+
+	The PELs are first brought up to date, so the calendar starts
+	at the current time.
+     */
+    void rebucket() {
+      for (auto& dat : Base::_Min)
+	dat.stream(Base::_pecTime);
+      Base::_pecTime = 0;
+
+      currentIndex = 0;
       Base::_NP = 0;
-      linearLists.clear();
-      linearLists.resize(nlists+1, NO_LINK); /*+1 for overflow, NO_LINK for marking empty*/ 
+      Base::_CBT[1] = 0;
+      std::fill(Base::_Leaf.begin(), Base::_Leaf.end(), std::numeric_limits<size_t>::max());
+      linearLists.assign(nlists + 1, NO_LINK); /*+1 for overflow, NO_LINK for marking empty*/ 
 
-      //Now insert all PELs
-      for (unsigned long i = 1; i <= Base::_N; i++) {
+      for (size_t i = 1; i <= Base::_N; i++) {
 	Base::_Min[i].qIndex = NO_LINK;
 	Base::_Min[i].next = NO_LINK;
 	Base::_Min[i].previous = NO_LINK;
 	insertInEventQ(i);
       }
-
-      orderNextEvent();
     }
 
-
     ///////////////////////////BOUNDED QUEUE IMPLEMENTATION
     inline void insertInEventQ(const size_t p)
     {
@@ -179,11 +303,16 @@ namespace dynamo {
       if (i > (nlists-1)) /* account for wrap */
 	{
 	  i -= nlists;
-	  if(i>=currentIndex-1)
+	  //The lists before the current date hold the next wrap of the
+	  //calendar. There are none on the first date.
+	  if((currentIndex == 0) || (i>=currentIndex-1))
 	    //Its overflowed!
 	    i=nlists; /* store in overflow list */
 	}
 
+      ++_epochInserts;
+      _epochOverflows += (i == nlists);
+
 #ifdef DYNAMO_DEBUG
       if (i >= linearLists.size())
 	M_throw() << "i=" << p << " is out of range of linearLists (size()=" << linearLists.size() << ") box="<<box << " dt=" << Base::_Min[p].top()._dt << " scale="<<scale;
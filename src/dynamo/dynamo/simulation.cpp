@@ -29,10 +29,13 @@
 #include <dynamo/interactions/interaction.hpp>
 #include <dynamo/outputplugins/misc.hpp>
 #include <dynamo/globals/PBCSentinel.hpp>
+#include <magnet/thread/threadpool.hpp>
 #include <boost/filesystem.hpp>
 #include <dynamo/BC/BC.hpp>
 #include <iomanip>
 #include <set>
+#include <thread>
+#include <algorithm>
 
 //! The configuration file version, a version mismatch prevents an XML file load.
 static const std::string configFileVersion("1.5.0");
@@ -48,7 +51,8 @@ namespace dynamo
     nextPrintEvent(0),
     _force_unwrapped(false),
     primaryCellSize({1,1,1}),
-    ranGenerator(std::random_device()()),
+    randomSeed(std::random_device()()),
+    ranGenerator(randomSeed),
     lastRunMFT(0.0),
     simID(0),
     stateID(0),
@@ -241,6 +245,9 @@ namespace dynamo
     for (shared_ptr<OutputPlugin> & Ptr : outputPlugins)
       Ptr->initialise();
 
+    //The plugins have now declared which events they consume
+    ptrScheduler->initialiseOutputPluginDispatch();
+
     status = OUTPUTPLUGIN_INIT;
 
     _nextPrint = eventCount + eventPrintInterval;
@@ -637,25 +644,23 @@ namespace dynamo
     long double sumMass(0);
 
     //Determine the momentum discrepancy vector
-    for (Particle & Part : particles)
-      {
-	const double mass = species(Part)->getMass(Part.getID());
-	if (std::isinf(mass)) continue;
-	Vector pos(Part.getPosition()), vel(Part.getVelocity());
-	BCs->applyBC(pos,vel);
-	sumMV += vel * mass;
-	sumMass += mass;
-      }
+    for (const shared_ptr<Species>& sp : species)
+      sp->forEachParticle(particles, [&](const Particle& Part, const double mass) {
+	  if (std::isinf(mass)) return;
+	  Vector pos(Part.getPosition()), vel(Part.getVelocity());
+	  BCs->applyBC(pos,vel);
+	  sumMV += vel * mass;
+	  sumMass += mass;
+	});
   
     sumMV /= sumMass;
   
     Vector change = COMVelocity - sumMV;
-    for (Particle & Part : particles)
-      {
-	double mass = species(Part)->getMass(Part.getID());
-	if (std::isinf(mass)) continue;
-	Part.getVelocity() =  Part.getVelocity() + change;
-      }
+    for (const shared_ptr<Species>& sp : species)
+      sp->forEachParticle(particles, [&change](Particle& Part, const double mass) {
+	  if (!std::isinf(mass))
+	    Part.getVelocity() += change;
+	});
   }
 
   void 
@@ -696,12 +701,14 @@ namespace dynamo
   }
 
   size_t
-  Simulation::checkSystem()
+  Simulation::checkSystem(size_t nThreads)
   {
+    if (status != INITIALISED)
+      M_throw() << "Cannot check the state of an uninitialised simulation";
+
     dynamics->updateAllParticles();
 
     size_t errors = 0;
-    std::vector<Particle>::const_iterator iPtr1, iPtr2;
   
     for (const shared_ptr<Interaction>& interaction_ptr : interactions)
       {
@@ -709,17 +716,90 @@ namespace dynamo
 	errors += interaction_ptr->validateState();
       }
 
-    dout << "Testing all particle pairs for invalid states" << std::endl;
-    for (iPtr1 = particles.begin(); iPtr1 != particles.end(); ++iPtr1)
-      for (iPtr2 = iPtr1 + 1; iPtr2 != particles.end(); ++iPtr2)
-	errors += getInteraction(*iPtr1, *iPtr2)->validateState(*iPtr1, *iPtr2);
+    if (!nThreads)
+      nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    //Only the first few invalid states are reported, the rest are
+    //just counted.
+    const size_t max_reports = 100;
+
+    /*! \brief The result of validating a contiguous block of
+        particle IDs.
+
+	The validation is performed silently on the worker threads,
+	only the ID's of the first max_reports invalid pairs/locals
+	are kept so they can be reported (in ID order) on this
+	thread.
+    */
+    struct CheckBlock {
+      CheckBlock(): errors(0) {}
+      size_t errors;
+      std::vector<std::pair<size_t, size_t> > pairs;
+      std::vector<std::pair<size_t, size_t> > locals;
+    };
+
+    //Split the particles into several blocks per thread to balance
+    //the load of the neighbour list scans
+    const size_t nBlocks = std::min(N(), 8 * nThreads);
+    std::vector<CheckBlock> blocks(nBlocks);
+
+    dout << "Testing all neighbouring particle pairs for invalid states using " 
+	 << nThreads << " thread(s)" << std::endl;
+
+    magnet::thread::ThreadPool pool;
+    //A single thread is handled by the calling thread in wait()
+    pool.setThreadCount((nThreads > 1) ? nThreads : 0);
+
+    for (size_t block = 0; block < nBlocks; ++block)
+      pool.queueTask([this, block, nBlocks, &blocks, max_reports]() {
+	  CheckBlock& result = blocks[block];
+	  const size_t start = (N() * block) / nBlocks;
+	  const size_t end = (N() * (block + 1)) / nBlocks;
+	  for (size_t id1 = start; id1 < end; ++id1)
+	    {
+	      const Particle& p1 = particles[id1];
+	      std::unique_ptr<IDRange> ids(ptrScheduler->getParticleNeighbours(p1));
+	      for (const size_t id2 : *ids)
+		if ((id2 > id1) && getInteraction(p1, particles[id2])->validateState(p1, particles[id2], false))
+		  {
+		    ++result.errors;
+		    if (result.pairs.size() + result.locals.size() < max_reports)
+		      result.pairs.push_back(std::make_pair(id1, id2));
+		  }
+	      
+	      for (size_t lID = 0; lID < locals.size(); ++lID)
+		if (locals[lID]->isInteraction(p1) && locals[lID]->validateState(p1, false))
+		  {
+		    ++result.errors;
+		    if (result.pairs.size() + result.locals.size() < max_reports)
+		      result.locals.push_back(std::make_pair(id1, lID));
+		  }
+	    }
+	});
+    
+    pool.wait();
 
-    for (const Particle& part : particles)
-      for (const shared_ptr<Local>& lcl : locals)
-	if (lcl->isInteraction(part))
-	  errors += lcl->validateState(part);
+    //Now report the collected invalid states, this must be done
+    //serially as the output streams are not thread safe.
+    size_t reports = 0, block_errors = 0;
+    for (const CheckBlock& result : blocks)
+      {
+	block_errors += result.errors;
+
+	for (const auto& pair : result.pairs)
+	  if (reports++ < max_reports)
+	    getInteraction(particles[pair.first], particles[pair.second])->validateState(particles[pair.first], particles[pair.second], true);
+
+	for (const auto& local : result.locals)
+	  if (reports++ < max_reports)
+	    locals[local.second]->validateState(particles[local.first], true);
+      }
+
+    if (block_errors > max_reports)
+      derr << "Over " << max_reports << " invalid particle states, further output was suppressed (total of " 
+	   << block_errors << " invalid states detected)" << std::endl;
     
-    return errors;
+    return errors + block_errors;
   }
 
   void
@@ -23,6 +23,7 @@
 #include <dynamo/property.hpp>
 #include <dynamo/units/units.hpp>
 #include <magnet/function/delegate.hpp>
+#include <magnet/math/philox.hpp>
 #include <random>
 #include <vector>
 
@@ -211,8 +212,16 @@ namespace dynamo
       overlapped state, but this error state is a minor precision
       error. Therefore, there may be around 2 errors which are just
       minor precision errors and can be discounted.
+
+      Only particle pairs returned by the Scheduler's neighbour list
+      (i.e., within \ref getLongestInteraction()) are tested. The
+      particles are split into blocks which are validated in parallel,
+      and only the first 100 invalid states are printed.
+
+      \param nThreads The number of threads to use for the pair
+      tests. If zero, the hardware concurrency is used.
     */
-    size_t checkSystem();
+    size_t checkSystem(size_t nThreads = 0);
 
     void addSystemTicker();
     
@@ -363,8 +372,35 @@ namespace dynamo
     /*! \brief The size of the primary image/cell of the simulation. */
     Vector  primaryCellSize;
 
+    /*! \brief The seed of the random number generators. */
+    unsigned int randomSeed;
+
     /*! \brief The random number generator of the system. */
     mutable baseRNG ranGenerator;
+
+    /*! \brief Seeds the random number generators of the system. */
+    void seed(unsigned int s)
+    {
+      randomSeed = s;
+      ranGenerator.seed(s);
+    }
+
+    /*! \brief Returns a counter-based random number stream.
+
+      The numbers drawn from ranGenerator depend on every previous
+      draw, so its users must run in a fixed order. The streams
+      returned here only depend on the seed and simID of the
+      Simulation and the two identifiers passed, so they are
+      reproducible whatever order (or thread) they are used in.
+
+      Particle events identify their stream by the particle ID and
+      the current eventCount. System events use N() plus their
+      System ID, and a count of their own events. Tests on a pair of
+      particles use the streams above these, offset by the pair's
+      IDs, and the current eventCount.
+     */
+    magnet::math::Philox getRandomStream(size_t streamID, size_t counter) const
+    { return magnet::math::Philox((std::uint64_t(simID) << 32) | randomSeed, counter, streamID); }
     
     /*! \brief The collection of OutputPlugin's operating on this system.
      */
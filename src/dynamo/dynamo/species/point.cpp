@@ -62,4 +62,16 @@ namespace dynamo {
     else
       return 0.5 * part.getVelocity().nrm2() * mass;
   }
+
+  double
+  SpPoint::getKineticEnergy() const
+  {
+    if (std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
+      return Species::getKineticEnergy();
+
+    double sum(0);
+    forEachParticle(Sim->particles, [&sum](const Particle& part, const double mass)
+		    { if (!std::isinf(mass)) sum += part.getVelocity().nrm2() * mass; });
+    return 0.5 * sum;
+  }
 }
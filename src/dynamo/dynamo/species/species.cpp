@@ -23,6 +23,15 @@
 namespace dynamo {
   Species::~Species() {}
 
+  double
+  Species::getKineticEnergy() const
+  {
+    double sumEnergy(0);
+    for (const unsigned long ID : *range)
+      sumEnergy += getParticleKineticEnergy(ID);
+    return sumEnergy;
+  }
+
   shared_ptr<Species>
   Species::getClass(const magnet::xml::Node& XML, dynamo::Simulation* tmp, size_t nID)
   {
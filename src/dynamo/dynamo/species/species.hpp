@@ -53,7 +53,41 @@ namespace dynamo {
 
     virtual double getParticleKineticEnergy(size_t ID) const = 0;
 
+    /*! \brief The total kinetic energy of the particles of this
+      species.
+
+      The default implementation sums getParticleKineticEnergy(),
+      but derived classes may provide a faster bulk calculation.
+     */
+    virtual double getKineticEnergy() const;
+
     virtual double getDOF() const = 0;
+
+    /*! \brief Calls func(particle, mass) for every particle of this
+      species.
+
+      If the IDRange of the species is contiguous and its mass is
+      the same for every particle (the common case), the particles
+      are looped over directly, avoiding the virtual IDRange and
+      Property calls for each particle.
+
+      \param particles The particles of the Simulation (or a const
+      reference to them).
+     */
+    template<class Container, class Func>
+    void forEachParticle(Container& particles, Func func) const
+    {
+      unsigned long begin, end;
+      if (range->getContiguousRange(begin, end) && std::dynamic_pointer_cast<NumericProperty>(_mass))
+	{
+	  const double mass = _mass->getProperty(0);
+	  for (auto it = particles.begin() + begin; it != particles.begin() + end; ++it)
+	    func(*it, mass);
+	}
+      else
+	for (const unsigned long ID : *range)
+	  func(particles[ID], getMass(ID));
+    }
     
   protected:
     template<class T1>
@@ -57,6 +57,20 @@ namespace dynamo {
     return KE;
   }
 
+  double
+  SpSphericalTop::getKineticEnergy() const
+  {
+    double KE = SpPoint::getKineticEnergy();
+
+    for (const unsigned long ID : *range)
+      {
+	const double I = getScalarMomentOfInertia(ID);
+	if (!std::isinf(I))
+	  KE += 0.5 * I * Sim->dynamics->getRotData(ID).angularVelocity.nrm2();
+      }
+    return KE;
+  }
+
   void 
   SpSphericalTop::operator<<(const magnet::xml::Node& XML)
   {
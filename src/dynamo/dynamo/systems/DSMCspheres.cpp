@@ -30,9 +30,16 @@
 #include <magnet/xmlreader.hpp>
 
 namespace dynamo {
+  namespace {
+    //! \brief The number of candidate pairs tested together.
+    const size_t blockSize = 256;
+  }
+
   SysDSMCSpheres::SysDSMCSpheres(const magnet::xml::Node& XML, dynamo::Simulation* tmp): 
     System(tmp),
-    maxprob(0.0)
+    maxprob(0.0),
+    _blockCount(0),
+    _streamCount(0)
   {
     dt = std::numeric_limits<float>::infinity();
     operator<<(XML);
@@ -49,54 +56,80 @@ namespace dynamo {
     maxprob(0.0),
     e(ne),
     range1(r1),
-    range2(r2)
+    range2(r2),
+    _blockCount(0),
+    _streamCount(0)
   {
     sysName = nName;
     type = DSMC;
   }
 
+  void
+  SysDSMCSpheres::sampleCandidates(magnet::math::Philox& rng, const size_t count)
+  {
+    std::uniform_int_distribution<size_t> id1sampler(0, _ids1.size() - 1);
+    std::uniform_int_distribution<size_t> id2sampler(0, _ids2.size() - 1);
+
+    _normals.resize(NDIM * count);
+    rng.normal(_normals.data(), _normals.size());
+
+    _candidates.resize(count);
+    for (size_t i(0); i < count; ++i)
+      {
+	Dynamics::DSMCCandidate& candidate = _candidates[i];
+	candidate.p1 = _ids1[id1sampler(rng)];
+	candidate.p2 = _ids2[id2sampler(rng)];
+	
+	//Find another particle which is not p1
+	while (candidate.p2 == candidate.p1)
+	  candidate.p2 = _ids2[id2sampler(rng)];
+
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  candidate.rij[iDim] = _normals[NDIM * i + iDim];
+	
+	//This is the extra diameter term missing from the "factor" variable
+	candidate.rij *= diameter / candidate.rij.nrm();
+      }
+  }
+
   NEventData
   SysDSMCSpheres::runEvent()
   {
     dt = tstep;
-    std::normal_distribution<> norm_sampler;
-    std::uniform_real_distribution<> uniform_sampler;
-    std::uniform_int_distribution<size_t> id1sampler(0, range1->size() - 1);
-    std::uniform_int_distribution<size_t> id2sampler(0, range2->size() - 1);
+    magnet::math::Philox rng = Sim->getRandomStream(Sim->N() + ID, _streamCount++);
         
     //Find the likely maximum number of interacting pairs. The
     //addition of the random variable is a neat way to randomly pick
     //an extra pair to, on average, pick the correct number of
     //fractional pairs (thanks Severin!)
-    const size_t nmax = static_cast<size_t>(0.5 * maxprob * range1->size() + uniform_sampler(Sim->ranGenerator));
+    const size_t nmax = static_cast<size_t>(0.5 * maxprob * range1->size() + rng.uniform());
 
     NEventData retval;
 
-    for (size_t n = 0; n < nmax; ++n)
+    //The candidate pairs are sampled and their probabilities
+    //calculated in blocks, then accepted one at a time.
+    for (size_t n = 0; n < nmax; n += blockSize)
       {
-	Particle& p1(Sim->particles[*(range1->begin() + id1sampler(Sim->ranGenerator))]);
-	
-	size_t p2id = *(range2->begin() + id2sampler(Sim->ranGenerator));
-	
-	//Find another particle which is not p1
-	while (p2id == p1.getID())
-	  p2id = *(range2->begin()+id2sampler(Sim->ranGenerator));
-	
-	Particle& p2(Sim->particles[p2id]);
-	
-	Sim->dynamics->updateParticlePair(p1, p2);
-      
-	Vector rij;
-	for (size_t iDim(0); iDim < NDIM; ++iDim)
-	  rij[iDim] = norm_sampler(Sim->ranGenerator);
-	
-	//This is the extra diameter term missing from the "factor" variable
-	rij *= diameter / rij.nrm();
-      
-	if (Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij))
+	++_blockCount;
+	sampleCandidates(rng, std::min(blockSize, nmax - n));
+	Sim->dynamics->DSMCSpheresProbabilities(_candidates.begin(), _candidates.end(), factor);
+
+	for (std::vector<Dynamics::DSMCCandidate>::iterator it = _candidates.begin(); it != _candidates.end(); ++it)
 	  {
+	    //The probability must be recalculated if either particle
+	    //has already collided in this block
+	    if ((_lastCollision[it->p1] == _blockCount) || (_lastCollision[it->p2] == _blockCount))
+	      Sim->dynamics->DSMCSpheresProbabilities(it, it + 1, factor);
+
+	    if (it->prob > maxprob)
+	      maxprob = it->prob;
+
+	    if (!(it->prob > rng.uniform() * maxprob))
+	      continue;
+
 	    ++Sim->eventCount;
-	    retval.L2partChanges.push_back(PairEventData(Sim->dynamics->DSMCSpheresRun(p1, p2, e, rij)));
+	    _lastCollision[it->p1] = _lastCollision[it->p2] = _blockCount;
+	    retval.L2partChanges.push_back(PairEventData(Sim->dynamics->DSMCSpheresRun(Sim->particles[it->p1], Sim->particles[it->p2], e, it->rij)));
 	  }
       }
     return retval;
@@ -113,35 +146,26 @@ namespace dynamo {
     //magnitude. This is incase applyBC in the dynamics (and any
     //other function) expects realistic rij values.
     factor = 4.0 * range2->size() * diameter * M_PI * chi * tstep / Sim->getSimVolume();
+
+    _ids1.clear();
+    for (const size_t& id : *range1)
+      _ids1.push_back(id);
+
+    _ids2.clear();
+    for (const size_t& id : *range2)
+      _ids2.push_back(id);
+
+    _lastCollision.assign(Sim->N(), 0);
+    _blockCount = 0;
   
     if (maxprob == 0.0)
       {
-	std::normal_distribution<> norm_sampler;
-	std::uniform_int_distribution<size_t> id1sampler(0, range1->size() - 1);
-	std::uniform_int_distribution<size_t> id2sampler(0, range2->size() - 1);
-
 	//Just do some quick testing to get an estimate
-	for (size_t n = 0; n < 1000; ++n)
-	  {
-	    Particle& p1(Sim->particles[*(range1->begin() + id1sampler(Sim->ranGenerator))]);
-	  
-	    size_t p2id = *(range2->begin() + id2sampler(Sim->ranGenerator));
-	  
-	    while (p2id == p1.getID())
-	      p2id = *(range2->begin()+id2sampler(Sim->ranGenerator));
-	  
-	    Particle& p2(Sim->particles[p2id]);
-	  
-	    Sim->dynamics->updateParticlePair(p1, p2);
-	  
-	    Vector rij;
-	    for (size_t iDim(0); iDim < NDIM; ++iDim)
-	      rij[iDim] = norm_sampler(Sim->ranGenerator);
-	
-	    rij *= diameter / rij.nrm();
-	  
-	    Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij);
-	  }
+	magnet::math::Philox rng = Sim->getRandomStream(Sim->N() + ID, _streamCount++);
+	sampleCandidates(rng, 1000);
+	Sim->dynamics->DSMCSpheresProbabilities(_candidates.begin(), _candidates.end(), factor);
+	for (const Dynamics::DSMCCandidate& candidate : _candidates)
+	  maxprob = std::max(maxprob, candidate.prob);
       }
 
     if (maxprob > 0.5)
@@ -18,7 +18,9 @@
 #pragma once
 #include <dynamo/systems/system.hpp>
 #include <dynamo/simulation.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
 #include <dynamo/ranges/IDRange.hpp>
+#include <vector>
 
 namespace dynamo {
   class SysDSMCSpheres: public System
@@ -37,6 +39,11 @@ namespace dynamo {
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
+    /*! \brief Fills the candidate buffer with a block of randomly
+      selected pairs and separation vectors.
+     */
+    void sampleCandidates(magnet::math::Philox& rng, size_t count);
+
     double tstep;
     double chi;
     double d2;
@@ -47,5 +54,21 @@ namespace dynamo {
 
     shared_ptr<IDRange> range1;
     shared_ptr<IDRange> range2;
+
+    //! \brief The particle IDs of each range, for fast random selection.
+    std::vector<size_t> _ids1;
+    std::vector<size_t> _ids2;
+    //! \brief The reused buffer of candidate pairs.
+    std::vector<Dynamics::DSMCCandidate> _candidates;
+    //! \brief The reused buffer of normal random numbers.
+    std::vector<double> _normals;
+    /*! \brief The last block in which each particle collided, to
+      find candidates invalidated by an earlier collision in the
+      same block.
+     */
+    std::vector<size_t> _lastCollision;
+    size_t _blockCount;
+    //! \brief The number of random number streams used, see Simulation::getRandomStream.
+    size_t _streamCount;
   };
 }
@@ -82,8 +82,9 @@ namespace dynamo {
 
     NEventData SDat;
     for (const shared_ptr<Species>& species : Sim->species)
-      for (const unsigned long& partID : *species->getRange())
-	SDat.L1partChanges.push_back(ParticleEventData(Sim->particles[partID], *species, RESCALE));
+      species->forEachParticle(Sim->particles, [&](const Particle& part, double) {
+	  SDat.L1partChanges.push_back(ParticleEventData(part, *species, RESCALE));
+	});
     
     Sim->dynamics->updateAllParticles();
     Sim->dynamics->rescaleSystemKineticEnergy(_kT / currentkT);
@@ -21,8 +21,11 @@
 #include <dynamo/ranges/IDRange.hpp>
 #include <dynamo/interactions/potentials/potential.hpp>
 #include <map>
+#include <vector>
 
 namespace dynamo {
+  class ParticleEventData;
+
   class SysUmbrella: public System
   {
   public:
@@ -30,6 +33,17 @@ namespace dynamo {
   
     virtual NEventData runEvent();
 
+    //! \brief The current step of the umbrella potential.
+    size_t getStepID() const { return _stepID; }
+
+    //! \brief If the centres of mass are tracked using the event data.
+    bool isIncremental() const { return _incremental; }
+
+    /*! \brief The separation and relative velocity of the centres of
+        mass of the two ranges, as used to predict the events.
+     */
+    std::pair<Vector, Vector> getCOMSeparation() const;
+
     virtual void initialise(size_t);
 
     virtual void operator<<(const magnet::xml::Node&);
@@ -43,6 +57,47 @@ namespace dynamo {
 
     void recalculateTime();
 
+    /*! \brief Running sums to track the centre of mass of a range.
+
+      For free-streaming (Newtonian) dynamics, the centre of mass
+      moves with the total momentum, which only changes through the
+      events of the particles in the range. The sums are therefore
+      updated from the velocity changes of each event, rather than
+      looping over the entire range.
+     */
+    struct COMSums
+    {
+      /*! \brief If the range contains infinite masses, which are then
+          the only particles contributing to the sums (with unit
+          weight, as in Dynamics::getCOMPosVel()). */
+      bool infiniteMass;
+      //! \brief The total (weighted) mass of the range.
+      double mass;
+      //! \brief The mass weighted position relative to origin, at time.
+      Vector moment;
+      //! \brief The total momentum of the range.
+      Vector momentum;
+      Vector origin;
+      double time;
+    };
+
+    /*! \brief Recalculates the centre of mass sums from the particles,
+      removing any accumulated round-off error.
+     */
+    void resynchroniseSums();
+
+    //! \brief The position and velocity of the centre of mass at the current time.
+    std::pair<Vector, Vector> getCOMPosVel(const COMSums&) const;
+
+    //! \brief The weight of a particle in the sums of a range.
+    double getWeight(const COMSums&, size_t ID) const;
+
+    /*! \brief Updates the sums for an event of a particle.
+
+      \return If the particle is in either range.
+     */
+    bool updateSums(const ParticleEventData&);
+
     std::size_t _stepID;
     shared_ptr<Potential> _potential;
     shared_ptr<IDRange> range1;
@@ -50,6 +105,14 @@ namespace dynamo {
     double _energyScale;
     double _lengthScale;
     mutable std::map<size_t, double> _histogram;
+
+    //! \brief If the COMSums can be used (otherwise the ranges are scanned).
+    bool _incremental;
+    COMSums _sums[2];
+    //! \brief The ranges (bit 0 for range1, bit 1 for range2) of each particle.
+    std::vector<unsigned char> _membership;
+    //! \brief The events applied to the sums since they were last recalculated.
+    size_t _updatesSinceResync;
     mutable long double _lastSystemTime;
   };
 }
@@ -0,0 +1,86 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file dynatraj.cpp
+
+  \brief Contains the main() function for dynatraj, which converts
+  the binary trajectory files written by the Trajectory output plugin
+  into the text trajectory format.
+*/
+
+#include <dynamo/outputplugins/trajectoryformat.hpp>
+#include <boost/program_options.hpp>
+#include <fstream>
+
+/*! \brief Starting point for the dynatraj program.
+
+  \param argc The number of command line arguments.
+  \param argv A pointer to the array of command line arguments.
+*/
+int main(int argc, char *argv[])
+{
+  try
+    {
+      namespace po = boost::program_options;
+
+      boost::program_options::variables_map vm;
+      boost::program_options::options_description options("Program Options");
+
+      options.add_options()
+	("help", "Produces this message")
+	("data-file", po::value<std::string>(), "The binary trajectory file to convert")
+	("out-file,o", po::value<std::string>(), "The file to write the text trajectory to (defaults to standard output)")
+	;
+
+      boost::program_options::positional_options_description p;
+      p.add("data-file", 1);
+
+      boost::program_options::store(po::command_line_parser(argc, argv).
+				    options(options).positional(p).run(), vm);
+      boost::program_options::notify(vm);
+
+      if (vm.count("help") || !vm.count("data-file"))
+	{
+	  std::cout << "dynatraj  Copyright (C) 2011  Marcus N Campbell Bannerman\n"
+		    << "This program comes with ABSOLUTELY NO WARRANTY.\n"
+		    << "This is free software, and you are welcome to redistribute it\n"
+		    << "under certain conditions. See the licence you obtained with\n"
+		    << "the code\n"
+		    << "Usage : dynatraj <OPTION>...<trajectory.bin>\n"
+		    << "Converts a binary trajectory into the text trajectory format\n"
+		    << options << "\n";
+	  return 1;
+	}
+
+      std::ifstream in(vm["data-file"].as<std::string>(), std::ios::in | std::ios::binary);
+      if (!in)
+	M_throw() << "Could not open " << vm["data-file"].as<std::string>();
+
+      if (vm.count("out-file"))
+	{
+	  std::ofstream out(vm["out-file"].as<std::string>(), std::ios::out | std::ios::trunc);
+	  dynamo::trajectory::convertToText(in, out);
+	}
+      else
+	dynamo::trajectory::convertToText(in, std::cout);
+    }
+  catch (std::exception& cep)
+    {
+      fflush(stdout);
+      std::cerr << cep.what() << "\nMAIN: Reached Main Error Loop\n";
+      return 1;
+    }
+}
@@ -0,0 +1,138 @@
+#define BOOST_TEST_MODULE CaptureMap_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/interactions/captures.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+std::mt19937 RNG;
+
+typedef std::pair<size_t, size_t> IDPair;
+typedef std::vector<std::pair<IDPair, size_t> > Contents;
+
+//Collect the contents of a map as (lower ID, higher ID) pairs, in
+//the iteration order of the map
+template<class Map>
+Contents contents(const Map& map)
+{
+  Contents retval;
+  for (const auto& entry : map)
+    retval.push_back(std::make_pair(IDPair(entry.first.first, entry.first.second), entry.second));
+  return retval;
+}
+
+//Compare the AdjacencyCaptureMap against the default (hash map)
+//container under a random sequence of insertions, updates and
+//erasures
+BOOST_AUTO_TEST_CASE( Reference_comparison )
+{
+  RNG.seed(std::random_device()());
+  const size_t N = 50;
+  std::uniform_int_distribution<size_t> IDdist(0, N - 1);
+  std::uniform_int_distribution<size_t> valuedist(1, 5);
+  std::uniform_int_distribution<size_t> opdist(0, 3);
+
+  dynamo::detail::AdjacencyCaptureMap map;
+  std::unordered_map<dynamo::detail::PairKey, size_t> reference;
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.begin() == map.end());
+
+  for (size_t i(0); i < 20000; ++i)
+    {
+      const size_t p1 = IDdist(RNG);
+      size_t p2 = IDdist(RNG);
+      while (p2 == p1) p2 = IDdist(RNG);
+      const dynamo::detail::PairKey key(p1, p2);
+
+      switch (opdist(RNG))
+	{
+	case 0:
+	case 1:
+	  {
+	    const size_t value = valuedist(RNG);
+	    map[key] = value;
+	    reference[key] = value;
+	    break;
+	  }
+	case 2:
+	  BOOST_REQUIRE_EQUAL(map.erase(key), reference.erase(key));
+	  break;
+	case 3:
+	  {
+	    const auto it = map.find(key);
+	    const auto ref_it = reference.find(key);
+	    BOOST_REQUIRE_EQUAL(it == map.end(), ref_it == reference.end());
+	    if (ref_it != reference.end())
+	      {
+		BOOST_REQUIRE_EQUAL(it->first.first, ref_it->first.first);
+		BOOST_REQUIRE_EQUAL(it->first.second, ref_it->first.second);
+		BOOST_REQUIRE_EQUAL(it->second, ref_it->second);
+	      }
+	    break;
+	  }
+	}
+
+      BOOST_REQUIRE_EQUAL(map.count(key), reference.count(key));
+      BOOST_REQUIRE_EQUAL(map.size(), reference.size());
+      BOOST_REQUIRE_EQUAL(map.empty(), reference.empty());
+    }
+
+  BOOST_REQUIRE(!reference.empty());
+
+  //The iteration must visit exactly the stored entries, ordered by
+  //the lower and then the higher particle ID
+  const Contents mapContents = contents(map);
+  Contents referenceContents = contents(reference);
+  std::sort(referenceContents.begin(), referenceContents.end());
+  BOOST_CHECK(mapContents == referenceContents);
+  BOOST_CHECK_EQUAL(size_t(std::distance(map.begin(), map.end())), reference.size());
+
+  //Every entry must be found and compare equal
+  for (const auto& entry : reference)
+    {
+      const auto it = map.find(entry.first);
+      BOOST_REQUIRE(it != map.end());
+      BOOST_CHECK_EQUAL(it->second, entry.second);
+    }
+
+  //Empty the map through erasure
+  for (const auto& entry : referenceContents)
+    BOOST_CHECK_EQUAL(map.erase(dynamo::detail::PairKey(entry.first.first, entry.first.second)), 1);
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK_EQUAL(map.size(), 0);
+  BOOST_CHECK(map.begin() == map.end());
+}
+
+//The CaptureMap interface (which deletes entries set to zero) must
+//behave identically with either container
+BOOST_AUTO_TEST_CASE( CaptureMap_interface )
+{
+  typedef dynamo::detail::PairKey Key;
+
+  dynamo::detail::CaptureMap captureMap;
+  dynamo::detail::AdjacencyCaptureMap map;
+
+  captureMap[Key(3, 1)] = 2;
+  map[Key(3, 1)] = 2;
+  captureMap[Key(0, 7)] = 1;
+  map[Key(0, 7)] = 1;
+  captureMap[Key(2, 9)] = 4;
+  map[Key(2, 9)] = 4;
+  captureMap[Key(3, 1)] = 0;
+  map.erase(Key(1, 3));
+
+  BOOST_CHECK_EQUAL(captureMap.size(), map.size());
+  BOOST_CHECK_EQUAL(captureMap.count(Key(0, 7)), 1);
+  BOOST_CHECK_EQUAL(captureMap.count(Key(1, 3)), 0);
+
+  Contents captureContents = contents(captureMap);
+  std::sort(captureContents.begin(), captureContents.end());
+  BOOST_CHECK(captureContents == contents(map));
+
+  const dynamo::detail::CaptureMap& constMap = captureMap;
+  BOOST_CHECK_EQUAL(constMap[Key(7, 0)], 1);
+  BOOST_CHECK_EQUAL(constMap[Key(9, 2)], 4);
+  BOOST_CHECK_EQUAL(constMap[Key(1, 3)], 0);
+}
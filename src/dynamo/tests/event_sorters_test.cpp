@@ -321,3 +321,73 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(FEL_standard, T, FEL_types){
     }
   }
 }
+
+//Perform a mock simulation where the mean free time shrinks by two
+//orders of magnitude, so that the bounded priority queue must retune
+//its settings to keep the events in its calendar.
+BOOST_AUTO_TEST_CASE(BoundedPQ_retune)
+{
+  RNG.seed(std::random_device()());
+  const size_t N = 1000;
+  const size_t eventsPerParticle = 3;
+  const size_t steps = 20 * N;
+  dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > FEL;
+  std::vector<dynamo::Event> reference;
+
+  FEL.init(N);
+  for (size_t i(0); i < N * eventsPerParticle; ++i) {
+    const dynamo::Event e = genInteractionEvent(N, 1.0, 1);
+    reference.push_back(e);
+    FEL.push(e);
+  }
+
+  double firstListWidth = 0;
+  for (size_t i(0); i < steps; ++i) {
+    const double meanFreeTime = std::exp(-5.0 * i / steps);
+    const auto next_it = std::min_element(reference.begin(), reference.end());
+    const dynamo::Event nextEvent = *next_it;
+    const dynamo::Event testEvent = FEL.top();
+    
+    if (testEvent._type == dynamo::RECALCULATE) {
+      FEL.pop();
+      for (const dynamo::Event& e: reference)
+    	if (e._particle1ID == testEvent._particle1ID)
+    	  FEL.push(e);
+      continue;
+    }
+    
+    validateEvents(nextEvent, testEvent);
+    
+    auto test = [=](const dynamo::Event& e){
+      return (e._particle1ID == testEvent._particle1ID) || (e._particle1ID == testEvent._particle2ID)
+      || ((e._source == dynamo::INTERACTION) 
+	  && ((e._particle2ID == testEvent._particle1ID) || (e._particle2ID == testEvent._particle2ID)));
+    };
+    reference.erase(std::remove_if(reference.begin(), reference.end(), test), reference.end());
+    
+    FEL.invalidate(testEvent._particle1ID);
+    FEL.invalidate(testEvent._particle2ID);
+  
+    FEL.stream(testEvent._dt);
+    for (dynamo::Event& e: reference)
+      e._dt -= testEvent._dt;
+    
+    for (size_t j(0); j < eventsPerParticle; j++) {
+      const dynamo::Event newEvent1 = genInteractionEvent(N, meanFreeTime, 1, testEvent._particle1ID);
+      FEL.push(newEvent1);
+      reference.push_back(newEvent1);
+      const dynamo::Event newEvent2 = genInteractionEvent(N, meanFreeTime, 1, testEvent._particle2ID);
+      FEL.push(newEvent2);
+      reference.push_back(newEvent2);
+    }
+
+    if (!firstListWidth && FEL.getRetuneCount())
+      firstListWidth = FEL.getListWidth();
+  }
+
+  //The queue must have left the CBT mode, and then narrowed its
+  //lists as the events became more frequent.
+  BOOST_CHECK(FEL.getRetuneCount() > 1);
+  BOOST_CHECK(!std::isinf(FEL.getListWidth()));
+  BOOST_CHECK_LT(FEL.getListWidth(), 0.25 * firstListWidth);
+}
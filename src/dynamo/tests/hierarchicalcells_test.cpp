@@ -0,0 +1,168 @@
+#define BOOST_TEST_MODULE HierarchicalCells_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/ranges/IDRangeRange.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/globals/cellsHierarchical.hpp>
+#include <dynamo/outputplugins/misc.hpp>
+#include <random>
+
+std::mt19937 RNG;
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+//A dilute suspension of 8 large spheres (5x the diameter) in a
+//solvent of small hard spheres. If binary is false, all pairs use a
+//single HardSphere interaction with a per-particle diameter,
+//otherwise there are separate big-big, big-small and small-small
+//HardSphere interactions.
+void init(dynamo::Simulation& Sim, bool hierarchical, bool binary = false)
+{
+  RNG.seed(std::random_device()());
+  Sim.ranGenerator.seed(std::random_device()());
+
+  const double sizeRatio = 5;
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  std::unique_ptr<dynamo::UCell> bigpack(new dynamo::CUSC(std::array<long, 3>{{2, 2, 2}}, dynamo::Vector{1, 1, 1}, new dynamo::UParticle()));
+  bigpack->initialise();
+  std::vector<dynamo::Vector> bigSites(bigpack->placeObjects(dynamo::Vector{0,0,0}));
+
+  std::unique_ptr<dynamo::UCell> smallpack(new dynamo::CUFCC(std::array<long, 3>{{12, 12, 12}}, dynamo::Vector{1, 1, 1}, new dynamo::UParticle()));
+  smallpack->initialise();
+  std::vector<dynamo::Vector> smallSites(smallpack->placeObjects(dynamo::Vector{0,0,0}));
+
+  const double smallDiam = std::cbrt(0.5 / smallSites.size());
+  const double bigDiam = sizeRatio * smallDiam;
+
+  std::vector<dynamo::Vector> sites(bigSites);
+  for (const dynamo::Vector& site : smallSites)
+    {
+      bool overlap = false;
+      for (const dynamo::Vector& big : bigSites)
+	{
+	  dynamo::Vector rij = site - big;
+	  Sim.BCs->applyBC(rij);
+	  overlap |= (rij.nrm() < 0.5 * (smallDiam + bigDiam));
+	}
+      if (!overlap) sites.push_back(site);
+    }
+
+  dynamo::shared_ptr<dynamo::ParticleProperty> D(new dynamo::ParticleProperty(sites.size(), dynamo::Property::Units::Length(), "D", smallDiam));
+  for (size_t i(0); i < bigSites.size(); ++i)
+    D->getProperty(i) = bigDiam;
+  Sim._properties.push(D);
+
+  if (binary)
+    {
+      const size_t nBig = bigSites.size();
+      Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, bigDiam, 1.0, new dynamo::IDPairRangePair(new dynamo::IDRangeRange(0, nBig - 1), new dynamo::IDRangeRange(0, nBig - 1)), "BigBig")));
+      Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, 0.5 * (bigDiam + smallDiam), 1.0, new dynamo::IDPairRangePair(new dynamo::IDRangeRange(0, nBig - 1), new dynamo::IDRangeRange(nBig, sites.size() - 1)), "BigSmall")));
+      Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, smallDiam, 1.0, new dynamo::IDPairRangeAll(), "SmallSmall")));
+    }
+  else
+    Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, "D", new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(smallDiam);
+
+  //The small particles have a range of 3 small diameters from the
+  //big-small interaction, which is within a factor of 2 of the range
+  //of the big particles
+  if (hierarchical)
+    Sim.globals.push_back(dynamo::shared_ptr<dynamo::Global>(new dynamo::GCellsHierarchical(&Sim, "SchedulerNBList", binary ? 1.5 : 2)));
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(sites.size());
+  for (const dynamo::Vector & position : sites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+//Tests every pair in the system for overlaps, without using the
+//neighbour list being tested. Touching pairs may overlap by round-off
+//error, so only significant overlaps are counted.
+size_t countOverlaps(dynamo::Simulation& Sim)
+{
+  Sim.dynamics->updateAllParticles();
+  const auto D = Sim._properties.getProperty("D", dynamo::Property::Units::Length());
+  size_t overlaps = 0;
+  for (size_t i(0); i < Sim.N(); ++i)
+    for (size_t j(i + 1); j < Sim.N(); ++j)
+      {
+	const double d = D->getProperty(i, j);
+	overlaps += (Sim.dynamics->sphereOverlap(Sim.particles[i], Sim.particles[j], d) > 1e-8 * d);
+      }
+  return overlaps;
+}
+
+double runSimulation(bool hierarchical, bool binary = false)
+{
+  dynamo::Simulation Sim;
+  init(Sim, hierarchical, binary);
+  Sim.endEventCount = 200000;
+  Sim.addOutputPlugin("Misc");
+  Sim.initialise();
+
+  if (hierarchical)
+    {
+      const dynamo::GCellsHierarchical& nblist = dynamic_cast<const dynamo::GCellsHierarchical&>(*Sim.globals["SchedulerNBList"]);
+      BOOST_CHECK_EQUAL(nblist.getLevelCount(), 2);
+    }
+
+  while (Sim.runSimulationStep()) {}
+
+  BOOST_CHECK_EQUAL(countOverlaps(Sim), 0);
+
+  const double Temperature = Sim.getOutputPlugin<dynamo::OPMisc>()->getCurrentkT() / Sim.units.unitEnergy();
+  BOOST_CHECK_CLOSE(Temperature, 1.0, 0.000000001);
+
+  return Sim.getOutputPlugin<dynamo::OPMisc>()->getMFT();
+}
+
+BOOST_AUTO_TEST_CASE( Colloid_Suspension )
+{
+  const double cellsMFT = runSimulation(false);
+  const double hierarchicalMFT = runSimulation(true);
+
+  //Both neighbour lists must give the same dynamics (statistically)
+  BOOST_CHECK_CLOSE(hierarchicalMFT, cellsMFT, 3);
+}
+
+//The per-particle interaction ranges must only include the
+//interactions the particle can take part in, otherwise the small
+//particles take the range of the big-big interaction
+BOOST_AUTO_TEST_CASE( Binary_Mixture )
+{
+  const double cellsMFT = runSimulation(false, true);
+  const double hierarchicalMFT = runSimulation(true, true);
+
+  BOOST_CHECK_CLOSE(hierarchicalMFT, cellsMFT, 3);
+}
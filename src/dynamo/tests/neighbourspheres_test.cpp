@@ -0,0 +1,148 @@
+#define BOOST_TEST_MODULE NeighbourSpheres_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/globals/neighbourSpheres.hpp>
+#include <dynamo/outputplugins/misc.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <random>
+
+std::mt19937 RNG;
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+//Counts the neighbourhood changes (virtual events) of a neighbour list
+struct NeighbourhoodCounter
+{
+  NeighbourhoodCounter(): count(0) {}
+  void increment(const dynamo::Particle&, const size_t&) { ++count; }
+  size_t count;
+};
+
+//Counts the collisions, which are the only events it subscribes to
+struct CollisionCounter: public dynamo::OutputPlugin
+{
+  CollisionCounter(const dynamo::Simulation* sim): dynamo::OutputPlugin(sim, "CollisionCounter"), count(0) {}
+  virtual void initialise() { subscribeEvents(dynamo::INTERACTION, dynamo::CORE); }
+  virtual void eventUpdate(const dynamo::Event&, const dynamo::NEventData&) { ++count; }
+  size_t count;
+};
+
+void init(dynamo::Simulation& Sim, const double density, const bool spheres, const double skin)
+{
+  RNG.seed(std::random_device()());
+  Sim.ranGenerator.seed(std::random_device()());
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{7,7,7}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  if (spheres)
+    Sim.globals.push_back(dynamo::shared_ptr<dynamo::Global>(new dynamo::GNeighbourSpheres(&Sim, "SchedulerNBList", skin * particleDiam)));
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+//Equilibrates a hard-sphere fluid, then returns the mean free time
+//and the number of neighbourhood changes per collision. A zero skin
+//selects the default skin of the NeighbourSpheres.
+std::pair<double, double> runSimulation(const double density, const bool spheres, const double skin = 0)
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim, density, spheres, skin);
+    Sim.endEventCount = 100000;
+    Sim.initialise();
+    while (Sim.runSimulationStep()) {}
+    Sim.writeXMLfile("NSequil.xml");
+  }
+
+  //Reloading also tests the XML input/output of the neighbour list
+  dynamo::Simulation Sim;
+  Sim.loadXMLfile("NSequil.xml");
+  Sim.endEventCount = 200000;
+  Sim.addOutputPlugin("Misc");
+  dynamo::shared_ptr<CollisionCounter> collisions(new CollisionCounter(&Sim));
+  Sim.outputPlugins.push_back(collisions);
+  Sim.initialise();
+
+  dynamo::shared_ptr<dynamo::GNeighbourList> nblist = std::dynamic_pointer_cast<dynamo::GNeighbourList>(Sim.globals["SchedulerNBList"]);
+  BOOST_REQUIRE(nblist);
+  BOOST_CHECK_EQUAL(bool(std::dynamic_pointer_cast<dynamo::GNeighbourSpheres>(nblist)), spheres);
+  NeighbourhoodCounter counter;
+  nblist->_sigCellChange.connect<NeighbourhoodCounter, &NeighbourhoodCounter::increment>(&counter);
+
+  while (Sim.runSimulationStep()) {}
+
+  dynamo::OPMisc& opMisc = *Sim.getOutputPlugin<dynamo::OPMisc>();
+  BOOST_CHECK_CLOSE(opMisc.getCurrentkT() / Sim.units.unitEnergy(), 1.0, 0.000000001);
+  BOOST_CHECK_SMALL(opMisc.getCurrentMomentum().nrm() / Sim.units.unitMomentum(), 0.0000000001);
+  BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
+
+  //The event count of the reloaded simulation includes the
+  //equilibration events and the neighbourhood events, so the
+  //collisions are counted separately
+  BOOST_REQUIRE(collisions->count > 0);
+  return std::make_pair(opMisc.getMFT(), double(counter.count) / collisions->count);
+}
+
+BOOST_AUTO_TEST_CASE( Equilibrium_Simulation )
+{
+  const std::pair<double, double> spheres = runSimulation(0.5, true);
+
+  //Taken from Lue 2005 DOI:10.1063/1.1834498
+  const double expectedMFT = 0.13031;
+  BOOST_CHECK_CLOSE(spheres.first, expectedMFT, 1);
+}
+
+BOOST_AUTO_TEST_CASE( Cells_Comparison )
+{
+  //With a large skin, a particle in a dense fluid must be displaced
+  //much further to leave its sphere than to cross a cell boundary
+  const double density = 0.8;
+  const std::pair<double, double> cells = runSimulation(density, false);
+  const std::pair<double, double> spheres = runSimulation(density, true, 0.6);
+
+  BOOST_TEST_MESSAGE("Neighbourhood events per collision: Cells " << cells.second << ", NeighbourSpheres " << spheres.second);
+
+  BOOST_CHECK_CLOSE(spheres.first, cells.first, 2);
+  BOOST_CHECK_LT(spheres.second, cells.second);
+}
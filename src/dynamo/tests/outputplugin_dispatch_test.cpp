@@ -0,0 +1,116 @@
+#define BOOST_TEST_MODULE OutputPluginDispatch_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <random>
+
+std::mt19937 RNG;
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+void init(dynamo::Simulation& Sim, const double density)
+{
+  RNG.seed(std::random_device()());
+  Sim.ranGenerator.seed(std::random_device()());
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{5,5,5}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+//Counts the events it receives, with a configurable subscription
+struct CountingPlugin: public dynamo::OutputPlugin
+{
+  enum Mode { ALL, NONE, CORE };
+
+  CountingPlugin(const dynamo::Simulation* sim, Mode mode):
+    dynamo::OutputPlugin(sim, "Counting"), _mode(mode), _events(0), _coreEvents(0) {}
+
+  virtual void initialise()
+  {
+    if (_mode == NONE)
+      unsubscribeEvents();
+    else if (_mode == CORE)
+      subscribeEvents(dynamo::INTERACTION, dynamo::CORE);
+  }
+
+  virtual void eventUpdate(const dynamo::Event& event, const dynamo::NEventData&)
+  {
+    ++_events;
+    _coreEvents += (event._source == dynamo::INTERACTION) && (event._type == dynamo::CORE);
+  }
+
+  Mode _mode;
+  size_t _events;
+  size_t _coreEvents;
+};
+
+BOOST_AUTO_TEST_CASE( Subscriptions )
+{
+  dynamo::Simulation Sim;
+  init(Sim, 0.5);
+
+  dynamo::shared_ptr<CountingPlugin> all(new CountingPlugin(&Sim, CountingPlugin::ALL));
+  dynamo::shared_ptr<CountingPlugin> none(new CountingPlugin(&Sim, CountingPlugin::NONE));
+  dynamo::shared_ptr<CountingPlugin> core(new CountingPlugin(&Sim, CountingPlugin::CORE));
+  Sim.outputPlugins.push_back(all);
+  Sim.outputPlugins.push_back(none);
+  Sim.outputPlugins.push_back(core);
+
+  Sim.endEventCount = 20000;
+  Sim.initialise();
+  while (Sim.runSimulationStep()) {}
+
+  //The unsubscribed plugin must not receive any events
+  BOOST_CHECK_EQUAL(none->_events, 0);
+
+  //The default plugin receives every event, including the virtual
+  //cell transitions
+  BOOST_CHECK(all->_events >= Sim.eventCount);
+  BOOST_CHECK(all->_coreEvents > 0);
+
+  //The subscribed plugin receives exactly the core collisions
+  BOOST_CHECK_EQUAL(core->_events, all->_coreEvents);
+  BOOST_CHECK_EQUAL(core->_coreEvents, all->_coreEvents);
+}
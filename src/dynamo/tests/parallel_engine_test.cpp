@@ -0,0 +1,157 @@
+#define BOOST_TEST_MODULE ParallelEngine_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/outputplugins/misc.hpp>
+#include <dynamo/coordinator/engine/parallel.hpp>
+#include <dynamo/coordinator/engine/process.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <random>
+
+std::mt19937 RNG;
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+//Writes out an equilibrated hard-sphere fluid of 4000 particles
+void init(const std::string& filename, const double density)
+{
+  RNG.seed(std::random_device()());
+
+  dynamo::Simulation Sim;
+  Sim.ranGenerator.seed(std::random_device()());
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{10,10,10}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  double particleDiam = std::cbrt(density / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+
+  Sim.endEventCount = 100000;
+  Sim.initialise();
+  while (Sim.runSimulationStep()) {}
+  Sim.writeXMLfile(filename);
+}
+
+//Exposes the Simulation of the engine
+template<class Base>
+struct TestEngine: public Base
+{
+  TestEngine(const boost::program_options::variables_map& vm, magnet::thread::ThreadPool& tp):
+    Base(vm, tp) {}
+
+  dynamo::Simulation& getSimulation() { return Base::simulation; }
+};
+
+//Tests every pair in the system for overlaps, without using a
+//neighbour list. Touching pairs may overlap by round-off error, so
+//only significant overlaps are counted.
+size_t countOverlaps(dynamo::Simulation& Sim)
+{
+  Sim.dynamics->updateAllParticles();
+  const double d = Sim.getLongestInteraction();
+  size_t overlaps = 0;
+  for (size_t i(0); i < Sim.N(); ++i)
+    for (size_t j(i + 1); j < Sim.N(); ++j)
+      overlaps += (Sim.dynamics->sphereOverlap(Sim.particles[i], Sim.particles[j], d) > 1e-8 * d);
+  return overlaps;
+}
+
+//Runs the equilibrated system with a domain engine and tests the results
+template<class Base>
+void runEngine(const std::string& filename, const size_t events)
+{
+  namespace po = boost::program_options;
+  po::options_description opts;
+  opts.add_options()
+    ("config-file", po::value<std::vector<std::string> >());
+  dynamo::Engine::getCommonOptions(opts);
+  dynamo::EParallelDomainSimulation::getOptions(opts);
+
+  const std::string eventArg = "--events=" + std::to_string(events);
+  const std::string fileArg = "--config-file=" + filename;
+  const char* argv[] = {"dynarun", fileArg.c_str(), eventArg.c_str(), "--domains=4"};
+  po::variables_map vm;
+  po::store(po::parse_command_line(4, argv, opts), vm);
+  po::notify(vm);
+
+  magnet::thread::ThreadPool pool;
+  pool.setThreadCount(4);
+
+  TestEngine<Base> engine(vm, pool);
+  engine.initialisation();
+  engine.runSimulation();
+
+  dynamo::Simulation& Sim = engine.getSimulation();
+  BOOST_CHECK_EQUAL(Sim.eventCount, events);
+
+  //The events must mostly have been run in parallel
+  BOOST_CHECK(engine.getCommittedWindows() > 0);
+  BOOST_CHECK_LT(engine.getSerialEvents(), Sim.eventCount / 2);
+  BOOST_TEST_MESSAGE("Windows committed " << engine.getCommittedWindows() << ", rolled back " << engine.getRolledBackWindows()
+		     << ", serial events " << engine.getSerialEvents());
+
+  dynamo::OPMisc& opMisc = *Sim.getOutputPlugin<dynamo::OPMisc>();
+  BOOST_CHECK_CLOSE(opMisc.getCurrentkT() / Sim.units.unitEnergy(), 1.0, 0.000000001);
+  BOOST_CHECK_SMALL(opMisc.getCurrentMomentum().nrm() / Sim.units.unitMomentum(), 0.0000000001);
+  BOOST_CHECK_EQUAL(countOverlaps(Sim), 0);
+
+  //Taken from Lue 2005 DOI:10.1063/1.1834498
+  const double expectedMFT = 0.13031;
+  BOOST_CHECK_CLOSE(opMisc.getMFT(), expectedMFT, 1);
+
+  //The main scheduler must have been rebuilt after the windows, so
+  //that the simulation can continue serially
+  Sim.endEventCount += 1000;
+  while (Sim.runSimulationStep()) {}
+  BOOST_CHECK_EQUAL(Sim.eventCount, events + 1000);
+  BOOST_CHECK_EQUAL(countOverlaps(Sim), 0);
+}
+
+BOOST_AUTO_TEST_CASE( Equilibrium_Simulation )
+{
+  init("PEequil.xml", 0.5);
+  runEngine<dynamo::EParallelDomainSimulation>("PEequil.xml", 200000);
+}
+
+BOOST_AUTO_TEST_CASE( Multiprocess_Simulation )
+{
+  init("PMequil.xml", 0.5);
+  runEngine<dynamo::EProcessDomainSimulation>("PMequil.xml", 100000);
+}
@@ -0,0 +1,188 @@
+#define BOOST_TEST_MODULE ParticleDataIO_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+
+std::mt19937 RNG;
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+std::string readFile(const std::string& filename)
+{
+  std::ifstream file(filename);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+//A hard sphere fluid which is large enough to be split into several
+//chunks when it is read and written. Some particles are static and
+//outside the primary image.
+void init(dynamo::Simulation& Sim)
+{
+  RNG.seed(std::random_device()());
+  Sim.ranGenerator.seed(std::random_device()());
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{13,13,13}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  const double particleDiam = std::cbrt(0.5 / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position + dynamo::Vector{0, 0, double(nParticles % 3)}, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  for (size_t i(0); i < Sim.N(); i += 7)
+    Sim.particles[i].clearState(dynamo::Particle::DYNAMIC);
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+}
+
+//The ParticleData block as formatted by the original (serial,
+//std::ostream based) writer.
+std::string referenceParticleData(dynamo::Simulation& Sim, const bool round)
+{
+  std::ostringstream os;
+  os << std::setprecision(std::numeric_limits<double>::digits10 + 2 - 4 * round);
+  os << "  <ParticleData>\n";
+  for (size_t i(0); i < Sim.N(); ++i)
+    {
+      dynamo::Particle tmp(Sim.particles[i]);
+      Sim.BCs->applyBC(tmp.getPosition(), tmp.getVelocity());
+      tmp.getVelocity() *= (1.0 / Sim.units.unitVelocity());
+      tmp.getPosition() *= (1.0 / Sim.units.unitLength());
+
+      os << "    <Pt ID=\"" << tmp.getID() << "\"";
+      if (!tmp.testState(dynamo::Particle::DYNAMIC))
+	os << " Static=\"Static\"";
+      os << ">\n";
+      os << "      <P x=\"" << tmp.getPosition()[0] << "\" y=\"" << tmp.getPosition()[1] << "\" z=\"" << tmp.getPosition()[2] << "\"/>\n";
+      os << "      <V x=\"" << tmp.getVelocity()[0] << "\" y=\"" << tmp.getVelocity()[1] << "\" z=\"" << tmp.getVelocity()[2] << "\"/>\n";
+      os << "    </Pt>\n";
+    }
+  os << "  </ParticleData>\n";
+  return os.str();
+}
+
+std::string extractParticleData(const std::string& contents)
+{
+  const size_t start = contents.find("  <ParticleData>");
+  const std::string endTag = "  </ParticleData>\n";
+  const size_t end = contents.find(endTag);
+  BOOST_REQUIRE(start != std::string::npos);
+  BOOST_REQUIRE(end != std::string::npos);
+  return contents.substr(start, end + endTag.size() - start);
+}
+
+//The formatting of doubles by the XmlStream must be identical to
+//that of a std::ostream
+BOOST_AUTO_TEST_CASE( Double_formatting )
+{
+  RNG.seed(std::random_device()());
+  std::vector<double> values{0.0, -0.0, 1.0, -1.0, 0.1, 1e-300, 4.9e-324, 1e300,
+      std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+      std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::quiet_NaN(), 123456789012345678.0, 1.0 / 3.0};
+  std::uniform_real_distribution<> mantissa(-10, 10);
+  std::uniform_int_distribution<> exponent(-30, 30);
+  for (size_t i(0); i < 10000; ++i)
+    values.push_back(mantissa(RNG) * std::pow(10.0, exponent(RNG)));
+
+  for (const int precision : {6, 13, 17})
+    {
+      magnet::xml::XmlStream XML;
+      XML << std::setprecision(precision) << magnet::xml::tag("Values") << magnet::xml::chardata();
+      std::ostringstream reference;
+      reference << std::setprecision(precision) << "<Values>\n";
+      for (const double& value : values)
+	{
+	  XML << value << " ";
+	  reference << value << " ";
+	}
+      XML << magnet::xml::endtag("Values");
+      reference << "</Values>\n";
+
+      XML.write_file("doubles.xml");
+      BOOST_CHECK(readFile("doubles.xml") == reference.str());
+    }
+}
+
+//The chunked writer must be byte identical to the original writer
+BOOST_AUTO_TEST_CASE( Byte_identical_output )
+{
+  dynamo::Simulation Sim;
+  init(Sim);
+  BOOST_REQUIRE(Sim.N() > 8192);
+
+  for (const bool round : {true, false})
+    {
+      Sim.writeXMLfile("particledata.xml", true, round);
+      BOOST_CHECK(extractParticleData(readFile("particledata.xml")) == referenceParticleData(Sim, round));
+    }
+}
+
+//The chunked reader must recover the particles in order
+BOOST_AUTO_TEST_CASE( Round_trip )
+{
+  dynamo::Simulation Sim;
+  init(Sim);
+  Sim.writeXMLfile("particledata.xml", false);
+
+  dynamo::Simulation Sim2;
+  Sim2.loadXMLfile("particledata.xml");
+  BOOST_REQUIRE_EQUAL(Sim2.N(), Sim.N());
+
+  const double lengthScale = Sim.units.unitLength() / Sim2.units.unitLength();
+  const double velocityScale = Sim.units.unitVelocity() / Sim2.units.unitVelocity();
+  for (size_t i(0); i < Sim.N(); ++i)
+    {
+      const dynamo::Particle& p1 = Sim.particles[i];
+      const dynamo::Particle& p2 = Sim2.particles[i];
+      BOOST_REQUIRE_EQUAL(p2.getID(), i);
+      BOOST_REQUIRE_EQUAL(p1.testState(dynamo::Particle::DYNAMIC), p2.testState(dynamo::Particle::DYNAMIC));
+      BOOST_REQUIRE_SMALL((p1.getPosition() - p2.getPosition() * lengthScale).nrm() / Sim.units.unitLength(), 1e-13);
+      BOOST_REQUIRE_SMALL((p1.getVelocity() - p2.getVelocity() * velocityScale).nrm() / Sim.units.unitVelocity(), 1e-13);
+    }
+
+  //Rewriting the loaded configuration with rounding must give the
+  //same file
+  Sim.writeXMLfile("particledata1.xml", false, true);
+  Sim2.writeXMLfile("particledata2.xml", false, true);
+  BOOST_CHECK(extractParticleData(readFile("particledata1.xml")) == extractParticleData(readFile("particledata2.xml")));
+}
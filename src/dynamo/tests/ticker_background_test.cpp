@@ -0,0 +1,109 @@
+#define BOOST_TEST_MODULE TickerBackground_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/heapPEL.hpp>
+#include <dynamo/schedulers/sorters/CBTFEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/squarebond.hpp>
+#include <dynamo/interactions/squarewell.hpp>
+#include <dynamo/topology/chain.hpp>
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+std::mt19937 RNG;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+//A single square-well chain, without a thermostat so that the
+//dynamics are deterministic.
+void init(dynamo::Simulation& Sim)
+{
+  const double diameter = 1.6;
+  const double lambda = 1.0;
+  const double welldepth = 1.5;
+  const double elasticity = 1.0;
+  const double bondinner = 0.9;
+  const double bondouter = 1.1;
+  const size_t N = 50;
+
+  RNG.seed(std::random_device()());
+  Sim.ranGenerator.seed(std::random_device()());
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCNone(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new dynamo::CBTFEL<dynamo::HeapPEL>()));
+  Sim.primaryCellSize = dynamo::Vector{50, 50, 50};
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::ISquareBond(&Sim, bondinner, bondouter / bondinner, elasticity, new dynamo::IDPairRangeChains(0, N - 1, N), "Bonds")));
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::ISquareWell(&Sim, diameter, lambda, welldepth, elasticity, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.topology.push_back(dynamo::shared_ptr<dynamo::Topology>(new dynamo::TChain(&Sim, 1, "Chain")));
+  Sim.topology.back()->addMolecule(new dynamo::IDRangeAll(&Sim));
+
+  for (size_t i = 0; i < N; ++i)
+    Sim.particles.push_back(dynamo::Particle(dynamo::Vector{0 + (bondinner + 0.95 * (bondouter - bondinner)) * i, 0, 0}, getRandVelVec() * Sim.units.unitVelocity(), Sim.particles.size()));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+}
+
+//Runs the configuration with the ticker plugins and returns their output
+std::string runPlugins(const std::string& options)
+{
+  const char* plugins[] = {"MSDCorrelator", "VACF", "ChainBondLength", "ChainBondAngles"};
+
+  dynamo::Simulation Sim;
+  Sim.loadXMLfile("TickerBackground.xml");
+  Sim.endEventCount = 200000;
+  for (const char* plugin : plugins)
+    Sim.addOutputPlugin(plugin + options);
+  Sim.initialise();
+  while (Sim.runSimulationStep(true)) {}
+
+  magnet::xml::XmlStream XML;
+  XML << magnet::xml::tag("Plugins");
+  for (const dynamo::shared_ptr<dynamo::OutputPlugin>& ptr : Sim.outputPlugins)
+    ptr->output(XML);
+  XML << magnet::xml::endtag("Plugins");
+  XML.write_file("TickerBackground.out.xml");
+
+  std::ifstream file("TickerBackground.out.xml");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+//The background analysis must give exactly the same results as the
+//inline analysis
+BOOST_AUTO_TEST_CASE( Background_equivalence )
+{
+  {
+    dynamo::Simulation Sim;
+    init(Sim);
+    Sim.writeXMLfile("TickerBackground.xml");
+  }
+
+  const std::string inlineResults = runPlugins("");
+  const std::string backgroundResults = runPlugins(":Background");
+
+  BOOST_CHECK(inlineResults.size() > 1000);
+  BOOST_CHECK(inlineResults == backgroundResults);
+}
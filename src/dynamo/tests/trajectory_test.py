@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+#   dynamo:- Event driven molecular dynamics simulator
+#   http://www.dynamomd.org
+#   Copyright (C) 2009  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+#
+#   This program is free software: you can redistribute it and/or
+#   modify it under the terms of the GNU General Public License
+#   version 3 as published by the Free Software Foundation.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Runs the same (deterministic) hard sphere simulation twice, once
+# writing a text trajectory and once writing a binary trajectory. The
+# binary trajectory converted by dynatraj must be identical to the
+# text trajectory.
+import os
+import sys
+import getopt
+import subprocess
+
+shortargs=""
+longargs=["dynarun=", "dynamod=", "dynatraj="]
+try:
+    options, args = getopt.gnu_getopt(sys.argv[1:], shortargs, longargs)
+except getopt.GetoptError as err:
+    print(str(err))
+    sys.exit(2)
+
+dynarun_cmd="NOT SET"
+dynamod_cmd="NOT SET"
+dynatraj_cmd="NOT SET"
+
+for o,a in options:
+    if o == "--dynarun":
+        dynarun_cmd = a
+    if o == "--dynamod":
+        dynamod_cmd = a
+    if o == "--dynatraj":
+        dynatraj_cmd = a
+
+for name,exe in [("dynamod", dynamod_cmd), ("dynarun", dynarun_cmd), ("dynatraj", dynatraj_cmd)]:
+    if not(os.path.isfile(exe) and os.access(exe, os.X_OK)):
+        raise RuntimeError("Failed to find "+name+" executabe at "+exe+"\,"+str(sys.argv))
+
+def run(cmd):
+    print("Running "+" ".join(cmd))
+    if subprocess.call(cmd) != 0:
+        raise RuntimeError("Failed to run "+" ".join(cmd))
+
+for f in ["trajectory.out", "trajectory.bin", "trajectory_text.out", "trajectory_binary.out"]:
+    if os.path.isfile(f):
+        os.remove(f)
+
+run([dynamod_cmd, "-m0", "-C4", "-d0.5", "-otraj_config.xml"])
+
+run([dynarun_cmd, "traj_config.xml", "-c10000", "-otraj_end.xml", "--out-data-file=traj_output.xml", "-LTrajectory"])
+os.rename("trajectory.out", "trajectory_text.out")
+
+run([dynarun_cmd, "traj_config.xml", "-c10000", "-otraj_end.xml", "--out-data-file=traj_output.xml", "-LTrajectory:Binary"])
+run([dynatraj_cmd, "trajectory.bin", "-otrajectory_binary.out"])
+
+text = open("trajectory_text.out", "rb").read()
+converted = open("trajectory_binary.out", "rb").read()
+
+if len(text) == 0:
+    print("The text trajectory is empty")
+    sys.exit(1)
+
+if text != converted:
+    textlines = text.splitlines()
+    convertedlines = converted.splitlines()
+    for i in range(min(len(textlines), len(convertedlines))):
+        if textlines[i] != convertedlines[i]:
+            print("The trajectories differ at line "+str(i+1))
+            print("Text:      "+repr(textlines[i]))
+            print("Converted: "+repr(convertedlines[i]))
+            break
+    print("Text lines "+str(len(textlines))+", converted lines "+str(len(convertedlines)))
+    sys.exit(1)
+
+print("The converted binary trajectory matches the text trajectory ("+str(len(text.splitlines()))+" lines)")
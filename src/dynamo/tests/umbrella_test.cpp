@@ -0,0 +1,158 @@
+#define BOOST_TEST_MODULE Umbrella_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/ranges/IDRangeRange.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/species/fixedCollider.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/interactions/squarebond.hpp>
+#include <dynamo/systems/umbrella.hpp>
+#include <magnet/xmlreader.hpp>
+#include <fstream>
+#include <random>
+
+std::mt19937 RNG;
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+dynamo::Vector getRandVelVec()
+{
+  //See http://mathworld.wolfram.com/SpherePointPicking.html
+  std::normal_distribution<> normal_dist(0.0, (1.0 / sqrt(double(NDIM))));
+
+  dynamo::Vector tmpVec;
+  for (size_t iDim = 0; iDim < NDIM; iDim++)
+    tmpVec[iDim] = normal_dist(RNG);
+
+  return tmpVec;
+}
+
+enum Mode { NEWTONIAN, SHEARING, INFINITE_MASS };
+
+//A hard sphere fluid with an umbrella potential between particle 2
+//and the pair of particles 0 and 1. The pair is bonded so that it
+//cannot be separated by more than half the box (where the centre of
+//mass becomes ambiguous). For the INFINITE_MASS mode, particle 0 has
+//an infinite mass.
+dynamo::shared_ptr<dynamo::SysUmbrella> init(dynamo::Simulation& Sim, const Mode mode)
+{
+  RNG.seed(std::random_device()());
+  Sim.ranGenerator.seed(std::random_device()());
+
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  if (mode == SHEARING)
+    Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCLeesEdwards(&Sim));
+  else
+    Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{4,4,4}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1,1,1};
+
+  const double particleDiam = std::cbrt(0.5 / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::ISquareBond(&Sim, particleDiam, 2.0, 1.0, new dynamo::IDPairRangeChains(0, 1, 2), "Bond")));
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  if (mode == INFINITE_MASS)
+    {
+      Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpFixedCollider(&Sim, new dynamo::IDRangeRange(0, 0), "Heavy", 0)));
+      Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeRange(1, latticeSites.size() - 1), 1.0, "Bulk", 1)));
+    }
+  else
+    Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  unsigned long nParticles = 0;
+  Sim.particles.reserve(latticeSites.size());
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, getRandVelVec() * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+
+  dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
+  dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
+
+  {
+    std::ofstream file("umbrella_system.xml");
+    file << "<System Type=\"Umbrella\" Name=\"Umbrella\" LengthScale=\"1\" EnergyScale=\"1\">"
+	 << "<Potential Type=\"Stepped\" Direction=\"Left\">"
+	 << "<Step R=\"3.5\" E=\"0.1\"/><Step R=\"2.5\" E=\"0.2\"/><Step R=\"1.5\" E=\"0.1\"/>"
+	 << "</Potential>"
+	 << "<IDRange Type=\"Ranged\" Start=\"2\" End=\"2\"/>"
+	 << "<IDRange Type=\"Ranged\" Start=\"0\" End=\"1\"/>"
+	 << "</System>";
+  }
+  magnet::xml::Document doc("umbrella_system.xml");
+  dynamo::shared_ptr<dynamo::SysUmbrella> umbrella(new dynamo::SysUmbrella(doc.getNode("System"), &Sim));
+  Sim.systems.push_back(umbrella);
+  return umbrella;
+}
+
+//Runs the simulation, comparing the centre of mass separation used
+//by the umbrella against a full recalculation from the particles
+void runTest(const Mode mode, const size_t events)
+{
+  dynamo::Simulation Sim;
+  dynamo::shared_ptr<dynamo::SysUmbrella> umbrella = init(Sim, mode);
+  Sim.endEventCount = events / 20;
+  Sim.initialise();
+
+  BOOST_CHECK_EQUAL(umbrella->isIncremental(), mode != SHEARING);
+
+  const dynamo::IDRangeRange range1(2, 2), range2(0, 1);
+  const size_t initialStep = umbrella->getStepID();
+  bool stepChanged = false;
+  for (size_t block(0); block < 20; ++block)
+    {
+      while (Sim.runSimulationStep()) {}
+      Sim.endEventCount += events / 20;
+      stepChanged |= (umbrella->getStepID() != initialStep);
+
+      const std::pair<dynamo::Vector, dynamo::Vector> separation = umbrella->getCOMSeparation();
+
+      Sim.dynamics->updateAllParticles();
+      const std::pair<dynamo::Vector, dynamo::Vector> com1 = Sim.dynamics->getCOMPosVel(range1);
+      const std::pair<dynamo::Vector, dynamo::Vector> com2 = Sim.dynamics->getCOMPosVel(range2);
+      dynamo::Vector r12 = com1.first - com2.first;
+      dynamo::Vector v12 = com1.second - com2.second;
+      Sim.BCs->applyBC(r12, v12);
+
+      //The infinite mass alone sets the centre of mass of its range
+      if (mode == INFINITE_MASS)
+	{
+	  dynamo::Vector rij = Sim.particles[2].getPosition() - Sim.particles[0].getPosition();
+	  Sim.BCs->applyBC(rij);
+	  BOOST_CHECK_SMALL((rij - r12).nrm() / Sim.units.unitLength(), 1e-10);
+	}
+
+      dynamo::Vector dr = separation.first - r12;
+      Sim.BCs->applyBC(dr);
+      BOOST_CHECK_SMALL(dr.nrm() / Sim.units.unitLength(), 1e-8);
+      BOOST_CHECK_SMALL((separation.second - v12).nrm() / Sim.units.unitVelocity(), 1e-8);
+    }
+
+  BOOST_CHECK(stepChanged);
+}
+
+BOOST_AUTO_TEST_CASE( Incremental_COM )
+{
+  runTest(NEWTONIAN, 100000);
+}
+
+BOOST_AUTO_TEST_CASE( Fallback_COM )
+{
+  runTest(SHEARING, 20000);
+}
+
+BOOST_AUTO_TEST_CASE( Infinite_Mass_COM )
+{
+  runTest(INFINITE_MASS, 100000);
+}
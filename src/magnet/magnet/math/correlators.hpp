@@ -22,6 +22,7 @@
 #include <vector>
 #include <utility>
 #include <tuple>
+#include <limits>
 
 namespace magnet {
   namespace math {    
@@ -236,6 +237,23 @@ namespace magnet {
 	return loops;
       }
 
+      /*! \brief Add an already integrated free streaming
+          contribution to \f$W^{(1)}\f$ and \f$W^{(2)}\f$.
+
+	  The integration period dt must not take the correlator past
+	  the next sample (see getTimeToNextSample()).
+      */
+      void addFreeStreamIntegral(const T& W1, const T& W2, double dt)
+      {
+	_continuous_sums += NVector<T, 2>({W1, W2});
+	_current_time += dt;
+      }
+
+      /*! \brief Returns the time remaining until the next sample is
+          taken.
+       */
+      double getTimeToNextSample() const { return _sample_time - _current_time; }
+
       /*! \brief Remove all collected data so far, but keep the
           _sample_time and correlator length.
        */
@@ -289,6 +307,13 @@ namespace magnet {
 	This class dynamically adds more correlators at exponentially
 	growing sample_times to ensure that all time scales are
 	monitored without a great computational or memory overhead.
+
+	The free streaming and impulsive contributions are
+	accumulated lazily. They are only passed to the contained
+	TimeCorrelator classes when one of them is about to take a
+	sample. Thus, setting values and free streaming are
+	typically \f$\mathcal{O}(1)\f$ operations, regardless of the
+	number of contained correlators.
      */
     template<class T>
     class LogarithmicTimeCorrelator
@@ -322,6 +347,9 @@ namespace magnet {
       {
 	_current_time = 0;
 	_freestream_values = _freestream_sum = _impulse_sum= std::pair<T,T>();
+	_pending_time = 0;
+	_pending_freestream = _pending_impulse = std::pair<T,T>();
+	_time_to_sample = std::numeric_limits<double>::infinity();
 	_sample_time /= (1 << _correlators.size());
 	_correlators.clear();
       }
@@ -334,9 +362,8 @@ namespace magnet {
       {
 	_impulse_sum.first += val1; 
 	_impulse_sum.second += val2;
-
-	for (Correlator& correlator : _correlators)
-	  correlator.addImpulse(val1, val2);
+	_pending_impulse.first += val1;
+	_pending_impulse.second += val2;
       }
 
       const T& getFreeStreamValue() const { return _freestream_values.first; }
@@ -350,14 +377,28 @@ namespace magnet {
       void setFreeStreamValue(const T& val1, const T& val2)
       {
 	_freestream_values = std::pair<T,T>(val1, val2);
-
-	for (Correlator& correlator : _correlators)
-	  correlator.setFreeStreamValue(val1, val2);
       }
 
       /*! \brief See \ref TimeCorrelator::freeStream(). */
       void freeStream(const double dt)
       {
+	const std::pair<T,T> integral(_freestream_values.first * dt, _freestream_values.second * dt);
+
+	//If no correlator will take a sample, just accumulate the
+	//contributions for later
+	if (((_current_time + dt) < _sample_time) && ((_pending_time + dt) < _time_to_sample))
+	  {
+	    _pending_freestream.first += integral.first;
+	    _pending_freestream.second += integral.second;
+	    _pending_time += dt;
+	    _freestream_sum.first += integral.first;
+	    _freestream_sum.second += integral.second;
+	    _current_time += dt;
+	    return;
+	  }
+
+	flush();
+
 	//Check if we need to add a new correlators as we've accessed
 	//longer time scales
 	while ((_current_time + dt) >= _sample_time)
@@ -392,8 +433,12 @@ namespace magnet {
 	    if (loopcount > 5) correlator_ptr = _correlators.erase(correlator_ptr);
 	  }
 
-	_freestream_sum.first += _freestream_values.first * dt;
-	_freestream_sum.second += _freestream_values.second * dt;
+	_time_to_sample = std::numeric_limits<double>::infinity();
+	for (const Correlator& correlator : _correlators)
+	  _time_to_sample = std::min(_time_to_sample, correlator.getTimeToNextSample());
+
+	_freestream_sum.first += integral.first;
+	_freestream_sum.second += integral.second;
 	_current_time += dt;
       }
 
@@ -445,6 +490,22 @@ namespace magnet {
 
 
     protected:
+      /*! \brief Passes the accumulated contributions to the contained
+          correlators.
+       */
+      void flush()
+      {
+	for (Correlator& correlator : _correlators)
+	  {
+	    correlator.addFreeStreamIntegral(_pending_freestream.first, _pending_freestream.second, _pending_time);
+	    correlator.addImpulse(_pending_impulse.first, _pending_impulse.second);
+	    correlator.setFreeStreamValue(_freestream_values.first, _freestream_values.second);
+	  }
+
+	_pending_time = 0;
+	_pending_freestream = _pending_impulse = std::pair<T,T>();
+      }
+
       double _sample_time;
       double _current_time;
       size_t _length;
@@ -452,6 +513,13 @@ namespace magnet {
       std::pair<T,T> _freestream_values;
       std::pair<T,T> _impulse_sum;
       std::pair<T,T> _freestream_sum;
+
+      //The contributions not yet passed to the correlators
+      double _pending_time;
+      std::pair<T,T> _pending_freestream;
+      std::pair<T,T> _pending_impulse;
+      //The minimum time until one of the correlators takes a sample
+      double _time_to_sample;
       
       Container _correlators;
     };
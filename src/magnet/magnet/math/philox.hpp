@@ -0,0 +1,159 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file philox.hpp
+ * \brief Contains the definition of the Philox counter-based random
+ * number generator.
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace magnet {
+  namespace math {
+    /*! \brief The Philox4x32-10 counter-based random number generator.
+
+      Counter-based generators have no internal state beyond a key and
+      a counter, and each block of output is a bijection of the
+      counter. Independent streams are therefore obtained simply by
+      choosing different keys/counters, and the numbers drawn from a
+      stream do not depend on the order in which the streams are
+      used, or on which thread uses them.
+
+      The 128 bit counter is split into a 96 bit stream identifier,
+      which is set on construction, and a 32 bit block index which is
+      incremented as the stream is consumed. This class satisfies the
+      UniformRandomBitGenerator requirements, so it may be used with
+      the std distributions.
+
+      See Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"
+      (2011) DOI:10.1145/2063384.2063405
+     */
+    class Philox
+    {
+    public:
+      typedef std::uint32_t result_type;
+      typedef std::array<std::uint32_t, 4> Counter;
+      typedef std::array<std::uint32_t, 2> Key;
+
+      /*! \brief Constructs a stream.
+
+	\param key The key of the generator (e.g., the seed).
+	\param stream1 The first identifier of the stream.
+	\param stream2 The second identifier of the stream (only the
+	lower 32 bits are used).
+       */
+      Philox(std::uint64_t key, std::uint64_t stream1, std::uint64_t stream2 = 0):
+	_key{{std::uint32_t(key), std::uint32_t(key >> 32)}},
+	_counter{{0, std::uint32_t(stream1), std::uint32_t(stream1 >> 32), std::uint32_t(stream2)}},
+	_index(4),
+	_hasSpareNormal(false)
+      {}
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+      result_type operator()()
+      {
+	if (_index == 4)
+	  {
+	    _block = block(_counter, _key);
+	    ++_counter[0];
+	    _index = 0;
+	  }
+	return _block[_index++];
+      }
+
+      //! \brief A uniform random number in the range (0,1].
+      double uniform()
+      {
+	const std::uint64_t val = (std::uint64_t((*this)()) << 21) ^ ((*this)() >> 11);
+	return (val + 1) * (1.0 / 9007199254740992.0);
+      }
+
+      //! \brief A standard normal random number.
+      double normal()
+      {
+	double val;
+	normal(&val, 1);
+	return val;
+      }
+
+      /*! \brief Fills an array with standard normal random numbers.
+
+	The Box-Muller transform is used, which generates the values
+	in pairs.
+       */
+      void normal(double* out, std::size_t count)
+      {
+	if (count && _hasSpareNormal)
+	  {
+	    *out++ = _spareNormal;
+	    --count;
+	    _hasSpareNormal = false;
+	  }
+
+	for (; count >= 2; count -= 2, out += 2)
+	  boxMuller(out[0], out[1]);
+
+	if (count)
+	  {
+	    boxMuller(*out, _spareNormal);
+	    _hasSpareNormal = true;
+	  }
+      }
+
+      //! \brief Calculates a single block of output of the generator.
+      static Counter block(Counter ctr, Key key)
+      {
+	for (size_t round(0); round < 10; ++round)
+	  {
+	    if (round)
+	      {
+		key[0] += 0x9E3779B9;
+		key[1] += 0xBB67AE85;
+	      }
+
+	    const std::uint64_t prod0 = std::uint64_t(0xD2511F53) * ctr[0];
+	    const std::uint64_t prod1 = std::uint64_t(0xCD9E8D57) * ctr[2];
+	    ctr = Counter{{std::uint32_t(prod1 >> 32) ^ ctr[1] ^ key[0], std::uint32_t(prod1),
+			   std::uint32_t(prod0 >> 32) ^ ctr[3] ^ key[1], std::uint32_t(prod0)}};
+	  }
+	return ctr;
+      }
+
+    private:
+      void boxMuller(double& a, double& b)
+      {
+	const double r = std::sqrt(-2.0 * std::log(uniform()));
+	const double theta = 2.0 * M_PI * uniform();
+	a = r * std::cos(theta);
+	b = r * std::sin(theta);
+      }
+
+      Key _key;
+      Counter _counter;
+      Counter _block;
+      size_t _index;
+      bool _hasSpareNormal;
+      double _spareNormal;
+    };
+  }
+}
@@ -0,0 +1,246 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file sharedringbuffer.hpp
+ * \brief Contains the definition of SharedRingBuffer
+ */
+
+#pragma once
+
+#include <magnet/exception.hpp>
+#include <sys/mman.h>
+#include <pthread.h>
+#include <ctime>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <new>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace magnet {
+  namespace thread {
+    /*! \brief A single-producer single-consumer byte stream between
+      two processes, stored in shared memory.
+
+      The buffer must be created before the process is forked, and
+      the two ends are then used by the parent and child processes
+      respectively. Writes block while the buffer is full and reads
+      block while it is empty, so messages of any size may be passed
+      through a buffer of fixed capacity.
+
+      Trivially copyable values (and std::vector's and std::string's
+      of them) may be sent and received directly, in the native
+      binary format, as both processes share the same executable.
+     */
+    class SharedRingBuffer
+    {
+      struct Header
+      {
+	pthread_mutex_t _mutex;
+	pthread_cond_t _dataAvailable;
+	pthread_cond_t _spaceAvailable;
+	//! \brief The total bytes written/read since creation.
+	size_t _written;
+	size_t _read;
+      };
+
+      SharedRingBuffer(const SharedRingBuffer&);
+      SharedRingBuffer& operator=(const SharedRingBuffer&);
+
+    public:
+      /*! \brief Maps the shared memory of the buffer.
+
+	\param capacity The size of the buffer in bytes.
+       */
+      SharedRingBuffer(size_t capacity):
+	_capacity(capacity)
+      {
+	if (!_capacity)
+	  M_throw() << "Cannot create a SharedRingBuffer without any capacity";
+
+	void* mem = mmap(NULL, sizeof(Header) + _capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (mem == MAP_FAILED)
+	  M_throw() << "Failed to map " << _capacity << " bytes of shared memory: " << std::strerror(errno);
+
+	_header = new (mem) Header;
+	_data = static_cast<char*>(mem) + sizeof(Header);
+	_header->_written = 0;
+	_header->_read = 0;
+
+	pthread_mutexattr_t mutexAttr;
+	pthread_mutexattr_init(&mutexAttr);
+	pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+	pthread_mutex_init(&_header->_mutex, &mutexAttr);
+	pthread_mutexattr_destroy(&mutexAttr);
+
+	pthread_condattr_t condAttr;
+	pthread_condattr_init(&condAttr);
+	pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+	pthread_cond_init(&_header->_dataAvailable, &condAttr);
+	pthread_cond_init(&_header->_spaceAvailable, &condAttr);
+	pthread_condattr_destroy(&condAttr);
+      }
+
+      /*! \brief Unmaps the buffer from this process.
+
+	The shared memory is only released once every process has
+	unmapped it.
+       */
+      ~SharedRingBuffer() { munmap(_header, sizeof(Header) + _capacity); }
+
+      /*! \brief Sets a function called whenever a read or write has
+	been blocked for a second.
+
+	This may throw an exception to abandon the transfer, e.g., if
+	the other process has died.
+       */
+      void setIdleFunction(const std::function<void()>& idle) { _idle = idle; }
+
+      //! \brief Writes raw bytes to the buffer, blocking while it is full.
+      void write(const void* src, size_t bytes)
+      {
+	const char* ptr = static_cast<const char*>(src);
+	Lock lock(*_header);
+	while (bytes)
+	  {
+	    while (_header->_written - _header->_read == _capacity)
+	      wait(_header->_spaceAvailable);
+
+	    const size_t start = _header->_written % _capacity;
+	    const size_t chunk = std::min(std::min(bytes, _capacity - (_header->_written - _header->_read)), _capacity - start);
+	    std::memcpy(_data + start, ptr, chunk);
+	    _header->_written += chunk;
+	    ptr += chunk;
+	    bytes -= chunk;
+	    pthread_cond_signal(&_header->_dataAvailable);
+	  }
+      }
+
+      //! \brief Reads raw bytes from the buffer, blocking while it is empty.
+      void read(void* dest, size_t bytes)
+      {
+	char* ptr = static_cast<char*>(dest);
+	Lock lock(*_header);
+	while (bytes)
+	  {
+	    while (_header->_written == _header->_read)
+	      wait(_header->_dataAvailable);
+
+	    const size_t start = _header->_read % _capacity;
+	    const size_t chunk = std::min(std::min(bytes, _header->_written - _header->_read), _capacity - start);
+	    std::memcpy(ptr, _data + start, chunk);
+	    _header->_read += chunk;
+	    ptr += chunk;
+	    bytes -= chunk;
+	    pthread_cond_signal(&_header->_spaceAvailable);
+	  }
+      }
+
+      template<class T>
+      void send(const T& val)
+      {
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be sent");
+	write(&val, sizeof(T));
+      }
+
+      template<class T>
+      void send(const std::vector<T>& vec)
+      {
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be sent");
+	send(vec.size());
+	write(vec.data(), vec.size() * sizeof(T));
+      }
+
+      void send(const std::string& str)
+      {
+	send(str.size());
+	write(str.data(), str.size());
+      }
+
+      template<class T>
+      void receive(T& val)
+      {
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be received");
+	read(&val, sizeof(T));
+      }
+
+      template<class T>
+      void receive(std::vector<T>& vec)
+      {
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be received");
+	size_t size;
+	receive(size);
+	vec.resize(size);
+	read(vec.data(), size * sizeof(T));
+      }
+
+      void receive(std::string& str)
+      {
+	size_t size;
+	receive(size);
+	str.resize(size);
+	read(&str[0], size);
+      }
+
+      template<class T>
+      T receive()
+      {
+	T val;
+	receive(val);
+	return val;
+      }
+
+    private:
+      struct Lock
+      {
+	Lock(Header& header): _mutex(header._mutex) { pthread_mutex_lock(&_mutex); }
+	~Lock() { pthread_mutex_unlock(&_mutex); }
+	pthread_mutex_t& _mutex;
+      };
+
+      /*! \brief Waits on a condition of the buffer, calling the idle
+	function every second.
+
+	The mutex is released while the idle function runs.
+       */
+      void wait(pthread_cond_t& cond)
+      {
+	timespec timeout;
+	clock_gettime(CLOCK_REALTIME, &timeout);
+	timeout.tv_sec += 1;
+	if ((pthread_cond_timedwait(&cond, &_header->_mutex, &timeout) == ETIMEDOUT) && _idle)
+	  {
+	    pthread_mutex_unlock(&_header->_mutex);
+	    try { _idle(); }
+	    catch (...)
+	      {
+		pthread_mutex_lock(&_header->_mutex);
+		throw;
+	      }
+	    pthread_mutex_lock(&_header->_mutex);
+	  }
+      }
+
+      Header* _header;
+      char* _data;
+      size_t _capacity;
+      std::function<void()> _idle;
+    };
+  }
+}
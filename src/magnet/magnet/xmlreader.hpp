@@ -26,6 +26,8 @@
 #include <fstream>
 #include <iostream>
 #include <vector>
+#include <cstdlib>
+#include <cctype>
 
 namespace magnet {
   //!Namespace enclosing the XML tools included in magnet.
@@ -132,6 +134,33 @@ namespace magnet {
       rapidxml::xml_node<> *_parent;
     };
 
+    /*! \brief Converts the attributes value to a double.
+
+      This specialisation converts the value in place using strtod,
+      avoiding the copy and stream used by boost::lexical_cast. The
+      value is not null terminated (the Document is parsed
+      non-destructively), but it is always followed by its closing
+      quote, which ends the conversion.
+     */
+    template<> inline double Attribute::as<double>() const
+    {
+      if (!valid())
+	M_throw() << (std::string("XML error: Missing attribute being converted\nXML Path: ")
+		      + detail::getPath(_parent) + "/INVALID");
+
+      const char* start = _attr->value();
+      const char* end = start + _attr->value_size();
+      char* converted_end = NULL;
+      double value = 0;
+      if ((start != end) && !std::isspace(*start))
+	value = std::strtod(start, &converted_end);
+
+      if (converted_end != end)
+	M_throw() << "The value \"" << getValue() << "\" will not cast to the correct type. Please check the attribute at the following XMLPath: " << getPath();
+
+      return value;
+    }
+
     /*! \brief Represents a Node of an XML Document.
      */
     class Node {
@@ -23,6 +23,7 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <cstdio>
 #ifdef DYNAMO_bzip2_support
 # include <bzlib.h>
 # include <vector>
@@ -52,11 +53,45 @@ namespace magnet {
       };
     
       inline XmlStream():
-	state(stateNone), prologWritten(false), FormatXML(false)
+	state(stateNone), prologWritten(false), FormatXML(false), fragmentDepth(0)
       {}
         
       inline ~XmlStream() {
-	while (tags.size()) endTag(tags.top());
+	while (tags.size() > fragmentDepth) endTag(tags.top());
+      }
+
+      /*! \brief Sets up this (empty) stream to write a fragment of
+        the document being written by the parent stream.
+
+	The fragment is formatted as though it were written as the
+	contents of the currently open tag of the parent (i.e., with
+	the same indentation, precision, and format flags). It is
+	inserted into the parent using appendFragment(). This allows
+	large parts of a document to be formatted concurrently.
+       */
+      inline void beginFragment(const XmlStream& parent)
+      {
+	tags = parent.tags;
+	fragmentDepth = tags.size();
+	prologWritten = true;
+	state = stateNone;
+	s.flags(parent.s.flags());
+	s.precision(parent.s.precision());
+      }
+
+      /*! \brief Appends a fragment (see beginFragment()) as the
+        contents of the currently open tag.
+       */
+      inline void appendFragment(const XmlStream& fragment)
+      {
+	if (fragment.tags.size() != fragment.fragmentDepth)
+	  M_throw() << "Appending an XML fragment with unclosed tags";
+
+	const std::string data = fragment.s.str();
+	if (data.empty()) return;
+	closeTagStart();
+	state = stateNone;
+	s.write(data.data(), data.size());
       }
 
       inline void write_file(std::string filename) {
@@ -135,6 +170,30 @@ namespace magnet {
 	return XML;
       }
 
+      /*! \brief Specialisation for doubles.
+
+	  The value is formatted with snprintf, bypassing the locale
+	  machinery of the std::ostream, whenever the result is
+	  identical (the default floating point format).
+       */
+      friend XmlStream& operator<<(XmlStream& XML, const double& value) {
+	const std::ios_base::fmtflags mask = std::ios_base::floatfield | std::ios_base::showpos
+	  | std::ios_base::showpoint | std::ios_base::uppercase;
+	if (!(XML.s.flags() & mask) && !XML.s.width())
+	  {
+	    char buf[32];
+	    const int precision = (XML.s.precision() < 0) ? 6 : int(XML.s.precision());
+	    const int len = std::snprintf(buf, sizeof(buf), "%.*g", precision, value);
+	    if ((len > 0) && (size_t(len) < sizeof(buf)))
+	      {
+		XML.s.write(buf, len);
+		return XML;
+	      }
+	  }
+	XML.s << value;
+	return XML;
+      }
+
       /*! \brief Specialisation for pointers. */
       template<class T>
       friend XmlStream& operator<<(XmlStream& XML, const std::shared_ptr<T>& value) {
@@ -168,6 +227,8 @@ namespace magnet {
       bool	prologWritten;
       std::ostringstream	tagName;
       bool        FormatXML;
+      //! \brief The number of tags inherited from the parent of a fragment.
+      size_t      fragmentDepth;
     
       //! \brief Closes the current tag.
       inline void closeTagStart(bool self_closed = false)
@@ -0,0 +1,67 @@
+#define BOOST_TEST_MODULE Correlator_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/math/correlators.hpp>
+#include <random>
+
+using namespace magnet::math;
+
+//Drives a LogarithmicTimeCorrelator and a plain TimeCorrelator with
+//the same (random) event sequence. The first level of the
+//logarithmic correlator must reproduce the TimeCorrelator, even
+//though its free streaming is accumulated lazily.
+BOOST_AUTO_TEST_CASE( LogarithmicTimeCorrelator_lazy_streaming )
+{
+  const double sample_time = 1.0;
+  const size_t length = 10;
+
+  LogarithmicTimeCorrelator<double> logcorr;
+  logcorr.resize(sample_time, length);
+  TimeCorrelator<double> corr(sample_time, length);
+
+  std::mt19937 RNG;
+  std::uniform_real_distribution<double> dist(0, 1);
+
+  //The LogarithmicTimeCorrelator fakes the data before the first
+  //sample using the average free streaming value, so keep this
+  //constant until the first sample is taken.
+  logcorr.setFreeStreamValue(0.5, 0.25);
+  corr.setFreeStreamValue(0.5, 0.25);
+  double time = 0;
+  while (time < 1.5 * sample_time)
+    {
+      const double dt = 0.1 * dist(RNG);
+      logcorr.freeStream(dt);
+      corr.freeStream(dt);
+      time += dt;
+    }
+
+  for (size_t i(0); i < 100000; ++i)
+    {
+      const double dt = 0.05 * dist(RNG);
+      logcorr.freeStream(dt);
+      corr.freeStream(dt);
+
+      const double W1 = dist(RNG) - 0.5, W2 = dist(RNG) - 0.5;
+      logcorr.addImpulse(W1, W2);
+      corr.addImpulse(W1, W2);
+
+      const double v1 = dist(RNG) - 0.5, v2 = dist(RNG) - 0.5;
+      logcorr.setFreeStreamValue(v1, v2);
+      corr.setFreeStreamValue(v1, v2);
+    }
+
+  for (bool i1 : {false, true})
+    for (bool i2 : {false, true})
+      {
+	const std::vector<LogarithmicTimeCorrelator<double>::Data> logdata = logcorr.getAveragedCorrelator(i1, i2);
+	const std::vector<double> data = corr.getAveragedCorrelator(i1, i2);
+
+	BOOST_REQUIRE(logdata.size() >= length);
+	for (size_t j(0); j < length; ++j)
+	  {
+	    BOOST_CHECK_CLOSE(logdata[j].time, sample_time * (j + 1), 1e-10);
+	    BOOST_CHECK_EQUAL(logdata[j].sample_count, corr.getSampleCount(j));
+	    BOOST_CHECK_CLOSE(logdata[j].value, data[j], 1e-6);
+	  }
+      }
+}
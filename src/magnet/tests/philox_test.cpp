@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE Philox_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/math/philox.hpp>
+#include <vector>
+
+using namespace magnet::math;
+
+void check_block(Philox::Counter ctr, Philox::Key key, Philox::Counter expected)
+{
+  const Philox::Counter result = Philox::block(ctr, key);
+  for (size_t i(0); i < 4; ++i)
+    BOOST_CHECK_EQUAL(result[i], expected[i]);
+}
+
+//The known answer tests of the Random123 library
+BOOST_AUTO_TEST_CASE( Philox_known_answers )
+{
+  check_block(Philox::Counter{{0, 0, 0, 0}}, Philox::Key{{0, 0}},
+	      Philox::Counter{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}});
+  check_block(Philox::Counter{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, Philox::Key{{0xffffffff, 0xffffffff}},
+	      Philox::Counter{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}});
+  check_block(Philox::Counter{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, Philox::Key{{0xa4093822, 0x299f31d0}},
+	      Philox::Counter{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}});
+}
+
+//Streams must be reproducible and independent of their use order
+BOOST_AUTO_TEST_CASE( Philox_streams )
+{
+  Philox a(12345, 1, 2), b(12345, 1, 3), a2(12345, 1, 2);
+
+  std::vector<Philox::result_type> aVals;
+  for (size_t i(0); i < 100; ++i)
+    {
+      b();
+      aVals.push_back(a());
+    }
+
+  size_t matches = 0;
+  for (size_t i(0); i < 100; ++i)
+    {
+      BOOST_CHECK_EQUAL(a2(), aVals[i]);
+      matches += (b() == aVals[i]);
+    }
+  BOOST_CHECK(matches < 2);
+}
+
+//Checks the batched normal numbers are reproducible and have the
+//correct moments.
+BOOST_AUTO_TEST_CASE( Philox_normal )
+{
+  const size_t N = 1000001;
+  std::vector<double> batch(N);
+  Philox rng(1, 0);
+  rng.normal(batch.data(), 1);
+  rng.normal(batch.data() + 1, N - 1);
+
+  Philox rng2(1, 0);
+  double sum = 0, sum2 = 0, sum4 = 0;
+  for (size_t i(0); i < N; ++i)
+    {
+      const double val = rng2.normal();
+      BOOST_CHECK_EQUAL(val, batch[i]);
+      sum += val;
+      sum2 += val * val;
+      sum4 += val * val * val * val;
+    }
+
+  BOOST_CHECK_SMALL(sum / N, 0.005);
+  BOOST_CHECK_CLOSE(sum2 / N, 1.0, 0.5);
+  BOOST_CHECK_CLOSE(sum4 / N, 3.0, 2);
+
+  Philox rng3(1, 0);
+  for (size_t i(0); i < 1000; ++i)
+    {
+      const double val = rng3.uniform();
+      BOOST_CHECK(val > 0);
+      BOOST_CHECK(val <= 1);
+    }
+}
@@ -0,0 +1,70 @@
+#define BOOST_TEST_MODULE SharedRingBuffer_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/thread/sharedringbuffer.hpp>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace magnet::thread;
+
+BOOST_AUTO_TEST_CASE( SharedRingBuffer_single_process )
+{
+  SharedRingBuffer buffer(16);
+
+  //Writes which wrap around the end of the buffer
+  for (int i(0); i < 100; ++i)
+    {
+      buffer.send(i);
+      buffer.send(double(i) * 0.5);
+      BOOST_CHECK_EQUAL(buffer.receive<int>(), i);
+      BOOST_CHECK_EQUAL(buffer.receive<double>(), double(i) * 0.5);
+    }
+
+  buffer.send(std::string("Hello"));
+  std::string str;
+  buffer.receive(str);
+  BOOST_CHECK_EQUAL(str, "Hello");
+}
+
+BOOST_AUTO_TEST_CASE( SharedRingBuffer_processes )
+{
+  //Both buffers are much smaller than the messages passed
+  SharedRingBuffer toChild(64), fromChild(100);
+
+  const pid_t pid = fork();
+  BOOST_REQUIRE(pid >= 0);
+
+  if (!pid)
+    {
+      //The child returns the sum of each message to the parent
+      while (true)
+	{
+	  std::vector<size_t> data;
+	  toChild.receive(data);
+	  if (data.empty()) _exit(0);
+
+	  size_t sum = 0;
+	  for (size_t val : data) sum += val;
+	  fromChild.send(sum);
+	  fromChild.send(data);
+	}
+    }
+
+  for (size_t N(1); N < 5000; N *= 3)
+    {
+      std::vector<size_t> data(N);
+      for (size_t i(0); i < N; ++i)
+	data[i] = i;
+
+      toChild.send(data);
+      BOOST_CHECK_EQUAL(fromChild.receive<size_t>(), N * (N - 1) / 2);
+
+      std::vector<size_t> echo;
+      fromChild.receive(echo);
+      BOOST_CHECK(echo == data);
+    }
+
+  toChild.send(std::vector<size_t>());
+  int status;
+  BOOST_CHECK_EQUAL(waitpid(pid, &status, 0), pid);
+  BOOST_CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+}